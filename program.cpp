@@ -9,22 +9,872 @@
 #include <exception>
 #include <cmath>
 #include <istream>
+#include <mutex>
+#include <tuple>
+#include <utility>
+#include <type_traits>
+#include <chrono>
+#include <cstdlib>
+#include <cstdio>
+#include <cerrno>
+#include <cctype>
+#include <list>
+#include <memory>
+#include <string_view>
+#include <bitset>
+#include <atomic>
+#include <thread>
+#include <condition_variable>
+#include <map>
+#include <filesystem>
+#include <new>
+#include <charconv>
+
+#if defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define FLOW_HAVE_SSE2
+#endif
+
+#ifndef _WIN32
+#include <poll.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/wait.h>
+#include <semaphore.h>
+#include <sys/stat.h>
+#endif
+
+#ifdef __linux__
+#include <sys/inotify.h>
+#endif
 
 using namespace std;
 
+//contor pentru alocarile pe heap: numarul lor si bytes alocati
+struct AllocationCounter {
+    atomic<long long> count;
+    atomic<long long> bytes;
+
+    constexpr AllocationCounter() : count(0), bytes(0) {}
+
+    void add(size_t size) {
+        count.fetch_add(1, memory_order_relaxed);
+        bytes.fetch_add(static_cast<long long>(size), memory_order_relaxed);
+    }
+
+    void reset() {
+        count = 0;
+        bytes = 0;
+    }
+};
+
+//clasa pentru numararea alocarilor facute prin operator new (modul de instrumentare, --count-allocations)
+//fiecare alocare este atribuita si rularii si tipului de pas care ruleaza in thread-ul respectiv
+class AllocationTracker {
+public:
+    static const int maxStepTypes = 32;
+    static const size_t maxNameLength = 32;
+
+private:
+    struct StepTypeCounter {
+        char name[maxNameLength];
+        AllocationCounter counter;
+
+        constexpr StepTypeCounter() : name{}, counter() {}
+    };
+
+    atomic<bool> enabled;
+    AllocationCounter total;
+    StepTypeCounter stepTypes[maxStepTypes];
+    atomic<int> stepTypeCount;
+    mutex registryMutex;
+
+    // Rularea si pasul in curs in thread-ul care aloca
+    static inline thread_local AllocationCounter* currentRun = nullptr;
+    static inline thread_local AllocationCounter* currentStep = nullptr;
+
+    // constexpr: obiectul este initializat static, deci operator new il poate folosi inainte de main()
+    constexpr AllocationTracker() : enabled(false), total(), stepTypes(), stepTypeCount(0) {}
+
+public:
+    static AllocationTracker& instance() {
+        static AllocationTracker tracker;
+        return tracker;
+    }
+
+    AllocationTracker(const AllocationTracker&) = delete;
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+    void setEnabled(bool value) { enabled = value; }
+    bool isEnabled() const { return enabled.load(memory_order_relaxed); }
+
+    long long getCount() const { return total.count; }
+    long long getBytes() const { return total.bytes; }
+
+    // Apelata de operator new; nu aloca si nu ia lock-uri
+    void record(size_t size) {
+        if (!isEnabled()) {
+            return;
+        }
+        total.add(size);
+        if (currentRun != nullptr) {
+            currentRun->add(size);
+        }
+        if (currentStep != nullptr) {
+            currentStep->add(size);
+        }
+    }
+
+    // Contorul unui tip de pas; apelata la constructia pasului, nu in timpul rularii
+    AllocationCounter* counterFor(const string& stepType) {
+        lock_guard<mutex> lock(registryMutex);
+        int count = stepTypeCount.load();
+        for (int i = 0; i < count; ++i) {
+            if (stepType == stepTypes[i].name) {
+                return &stepTypes[i].counter;
+            }
+        }
+        if (count >= maxStepTypes) {
+            return nullptr;
+        }
+        strncpy(stepTypes[count].name, stepType.c_str(), maxNameLength - 1);
+        stepTypeCount.store(count + 1);
+        return &stepTypes[count].counter;
+    }
+
+    void display() const {
+        if (!isEnabled()) {
+            return;
+        }
+        cout << "Heap allocations (all flows): " << total.count << " (" << total.bytes << " bytes)" << endl;
+        int count = stepTypeCount.load();
+        for (int i = 0; i < count; ++i) {
+            cout << "   " << stepTypes[i].name << ": " << stepTypes[i].counter.count << " ("
+                 << stepTypes[i].counter.bytes << " bytes)" << endl;
+        }
+    }
+
+    //clasa care atribuie alocarile unui bloc unei rulari
+    class RunScope {
+    private:
+        AllocationCounter* previous;
+
+    public:
+        RunScope(AllocationCounter& counter) : previous(currentRun) { currentRun = &counter; }
+        ~RunScope() { currentRun = previous; }
+
+        RunScope(const RunScope&) = delete;
+        RunScope& operator=(const RunScope&) = delete;
+    };
+
+    //clasa care atribuie alocarile unui bloc tipului de pas care ruleaza
+    class StepScope {
+    private:
+        AllocationCounter* previous;
+
+    public:
+        StepScope(AllocationCounter* counter) : previous(currentStep) { currentStep = counter; }
+        ~StepScope() { currentStep = previous; }
+
+        StepScope(const StepScope&) = delete;
+        StepScope& operator=(const StepScope&) = delete;
+    };
+};
+
+// GCC ar semnala free() din operator delete inlocuit, daca il inlineaza langa un new
+#if defined(__GNUC__)
+#define FLOW_NOINLINE __attribute__((noinline))
+#else
+#define FLOW_NOINLINE
+#endif
+
+// Toate alocarile trec prin AllocationTracker (new[] si varianta nothrow apeleaza aceasta functie)
+void* operator new(size_t size) {
+    AllocationTracker::instance().record(size);
+    void* memory = malloc(size == 0 ? 1 : size);
+    if (memory == nullptr) {
+        throw bad_alloc();
+    }
+    return memory;
+}
+
+FLOW_NOINLINE void operator delete(void* memory) noexcept {
+    free(memory);
+}
+
+FLOW_NOINLINE void operator delete(void* memory, size_t) noexcept {
+    free(memory);
+}
+
+//exceptie aruncata de un pas cand token-ul lui a fost anulat (deadline depasit)
+class StepCancelled : public runtime_error {
+public:
+    StepCancelled() : runtime_error("Deadline exceeded.") {}
+};
+
+//clasa pentru anularea cooperativa: pasii verifica token-ul in punctele in care pot astepta
+class CancellationToken {
+private:
+    atomic<bool> cancelled;
+    const CancellationToken* parent; // anularea parintelui (deadline-ul flow-ului) se propaga
+
+public:
+    CancellationToken(const CancellationToken* parentValue = nullptr) : cancelled(false), parent(parentValue) {}
+
+    void cancel() { cancelled = true; }
+    // Token-ul este resetat inaintea fiecarui pas; scrierea atomica se face doar daca a fost anulat
+    void reset() {
+        if (cancelled.load(memory_order_relaxed)) {
+            cancelled = false;
+        }
+    }
+    bool isCancelled() const { return cancelled || (parent != nullptr && parent->isCancelled()); }
+
+    void throwIfCancelled() const {
+        if (isCancelled()) {
+            throw StepCancelled();
+        }
+    }
+};
+
+//clasa pentru thread-ul care anuleaza token-urile al caror deadline a expirat
+class Watchdog {
+private:
+    typedef pair<chrono::steady_clock::time_point, long long> Key;
+
+    mutex watchdogMutex;
+    condition_variable changed;
+    vector<pair<Key, CancellationToken*>> deadlines; // ordonat dupa deadline; capacitatea se refoloseste
+    long long nextId;
+    bool stopping;
+    thread worker;
+
+    Watchdog() : nextId(0), stopping(false) {}
+
+public:
+    static Watchdog& instance() {
+        static Watchdog watchdog;
+        return watchdog;
+    }
+
+    ~Watchdog() {
+        {
+            lock_guard<mutex> lock(watchdogMutex);
+            stopping = true;
+        }
+        changed.notify_one();
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    // In procesul copil dupa fork() thread-ul nu mai exista si mutex-ul poate fi ramas blocat
+    void resetAfterFork() {
+        new (&watchdogMutex) mutex();
+        new (&changed) condition_variable();
+        new (&worker) thread();
+        deadlines.clear();
+        stopping = false;
+    }
+
+    Key arm(CancellationToken& token, chrono::milliseconds timeout) {
+        lock_guard<mutex> lock(watchdogMutex);
+        if (!worker.joinable()) {
+            worker = thread(&Watchdog::watch, this); // pornit la primul deadline
+        }
+        Key key(chrono::steady_clock::now() + timeout, nextId++);
+        deadlines.insert(findDeadline(key), make_pair(key, &token));
+        changed.notify_one();
+        return key;
+    }
+
+    void disarm(const Key& key) {
+        lock_guard<mutex> lock(watchdogMutex);
+        auto it = findDeadline(key);
+        if (it != deadlines.end() && it->first == key) {
+            deadlines.erase(it);
+        }
+    }
+
+private:
+    vector<pair<Key, CancellationToken*>>::iterator findDeadline(const Key& key) {
+        return lower_bound(deadlines.begin(), deadlines.end(), key,
+                           [](const pair<Key, CancellationToken*>& entry, const Key& value) { return entry.first < value; });
+    }
+
+    void watch() {
+        unique_lock<mutex> lock(watchdogMutex);
+        while (!stopping) {
+            if (deadlines.empty()) {
+                changed.wait(lock);
+                continue;
+            }
+            auto first = deadlines.begin();
+            if (chrono::steady_clock::now() >= first->first.first) {
+                first->second->cancel();
+                deadlines.erase(first);
+                continue;
+            }
+            changed.wait_until(lock, first->first.first);
+        }
+    }
+};
+
+//clasa care armeaza un deadline pe durata unui bloc (0 inseamna fara deadline)
+class DeadlineGuard {
+private:
+    pair<chrono::steady_clock::time_point, long long> key;
+    bool armed;
+
+public:
+    DeadlineGuard(CancellationToken& token, int timeoutMs) : armed(timeoutMs > 0) {
+        if (armed) {
+            key = Watchdog::instance().arm(token, chrono::milliseconds(timeoutMs));
+        }
+    }
+
+    ~DeadlineGuard() {
+        if (armed) {
+            Watchdog::instance().disarm(key);
+        }
+    }
+
+    DeadlineGuard(const DeadlineGuard&) = delete;
+    DeadlineGuard& operator=(const DeadlineGuard&) = delete;
+};
+
+// Mesaje scrise din alte thread-uri decat cel principal (watcher-ul de fisiere .flow)
+// cout nu este folosit acolo: starea lui (width, flags) nu este protejata; stdio are lock propriu
+// si, cu stdio sincronizat, acelasi buffer ca cout, deci ordinea mesajelor se pastreaza
+inline void printMessage(FILE* stream, const string& message) {
+    fprintf(stream, "%s\n", message.c_str());
+    fflush(stream);
+}
+
+#ifndef _WIN32
+//streambuf pentru cin care citeste direct din descriptorul 0
+//textul deja citit de la consola, dar inca nefolosit, este vizibil prin in_avail(),
+//iar cout si cerr raman sincronizate cu stdio
+class StandardInputBuffer : public streambuf {
+private:
+    char buffer[4096];
+
+    StandardInputBuffer() { setg(buffer, buffer, buffer); }
+
+public:
+    static StandardInputBuffer& instance() {
+        static StandardInputBuffer inputBuffer;
+        return inputBuffer;
+    }
+
+    StandardInputBuffer(const StandardInputBuffer&) = delete;
+    StandardInputBuffer& operator=(const StandardInputBuffer&) = delete;
+
+protected:
+    int underflow() override {
+        ssize_t size;
+        do {
+            size = read(STDIN_FILENO, buffer, sizeof(buffer));
+        } while (size < 0 && errno == EINTR);
+        if (size <= 0) {
+            return traits_type::eof();
+        }
+        setg(buffer, buffer, buffer + size);
+        return traits_type::to_int_type(buffer[0]);
+    }
+};
+#endif
+
+// Asteapta input fara sa blocheze peste deadline
+// Separatorii ramasi dupa raspunsul anterior (ex: '\n' de dupa un numar) sunt sariti fara sa blocheze;
+// pentru o linie de text se sare doar peste un '\n', ca un raspuns gol sa ramana posibil
+inline void waitForInput(istream& input, const CancellationToken& token, bool readsLine = false) {
+    streambuf* buffer = input.rdbuf();
+    if (readsLine) {
+        if (buffer->in_avail() > 0 && buffer->sgetc() == '\n') {
+            buffer->sbumpc();
+        }
+    } else {
+        while (buffer->in_avail() > 0 && isspace(buffer->sgetc())) {
+            buffer->sbumpc();
+        }
+    }
+#ifndef _WIN32
+    // Un fisier obisnuit nu blocheaza; consola, pipe-urile si FIFO-urile pot astepta oricat
+    struct stat status;
+    if (buffer == &StandardInputBuffer::instance() && buffer->in_avail() <= 0 && fstat(STDIN_FILENO, &status) == 0 &&
+        !S_ISREG(status.st_mode)) {
+        if (input.tie() != nullptr) {
+            input.tie()->flush(); // intrebarea trebuie sa fie vizibila cat timp asteptam
+        }
+        pollfd descriptor = { STDIN_FILENO, POLLIN, 0 };
+        while (poll(&descriptor, 1, 50) == 0) {
+            token.throwIfCancelled();
+        }
+    }
+#endif
+    token.throwIfCancelled();
+}
+
+class Step;
+
+// Tabel CSV: celulele sunt string_view-uri in textul fisierului, fara copii
+using CsvTable = vector<vector<string_view>>;
+
+//clasa pentru rezultatul publicat de un pas intr-o rulare
+//valorile text si tabel sunt imutabile si partajate, deci pot fi citite fara copiere si din alte thread-uri
+struct StepResult {
+    enum Kind { NONE, NUMBER, TEXT, TABLE };
+
+    Kind kind;
+    double number;
+    shared_ptr<const string> text;
+    shared_ptr<const CsvTable> table;
+
+    StepResult() : kind(NONE), number(0) {}
+};
+
+//clasa pentru starea unei rulari a unui flow
+//flow-ul si pasii lui raman read-only, valorile mutabile stau aici
+//fiecare pas isi publica rezultatul o singura data, iar pasii urmatori il citesc dupa ID
+class RunContext {
+private:
+    struct StepState {
+        StepResult result;
+        shared_ptr<string> ownedText; // buffer refolosit intre rulari pentru textele copiate
+        int errorCount;
+        int skippedCount;
+        int completedCount;
+        int timedOutCount;
+
+        StepState() : errorCount(0), skippedCount(0), completedCount(0), timedOutCount(0) {}
+    };
+    vector<const Step*> steps;
+    vector<StepState> states;
+    CancellationToken flowToken;
+    CancellationToken stepToken; // anulat de deadline-ul pasului curent sau de cel al flow-ului
+    AllocationCounter allocations; // alocarile facute in rularea curenta
+    // Stream-urile rularii: pasii citesc si scriu doar prin ele, deci rularile simultane nu folosesc cin/cout comune
+    istream* input;
+    ostream* output;
+    ostream* errors;
+
+public:
+    RunContext(const vector<Step*>& flowSteps, istream& inputValue = cin, ostream& outputValue = cout, ostream& errorsValue = cerr)
+        : steps(flowSteps.begin(), flowSteps.end()), states(flowSteps.size()), stepToken(&flowToken),
+          input(&inputValue), output(&outputValue), errors(&errorsValue) {}
+
+    RunContext(const RunContext&) = delete;
+    RunContext& operator=(const RunContext&) = delete;
+
+    CancellationToken& getFlowToken() { return flowToken; }
+    CancellationToken& getStepToken() { return stepToken; }
+    const CancellationToken& getCancellationToken() const { return stepToken; }
+    AllocationCounter& getAllocations() { return allocations; }
+    const AllocationCounter& getAllocations() const { return allocations; }
+    istream& getInput() const { return *input; }
+    ostream& getOutput() const { return *output; }
+    ostream& getErrors() const { return *errors; }
+
+    size_t getStepCount() const { return states.size(); }
+
+    // Pregateste contextul pentru o noua rulare (bufferele se pastreaza)
+    void reset() {
+        for (auto& state : states) {
+            state.result = StepResult();
+            state.errorCount = 0;
+            state.skippedCount = 0;
+            state.completedCount = 0;
+            state.timedOutCount = 0;
+        }
+        flowToken.reset();
+        stepToken.reset();
+        allocations.reset();
+    }
+
+    const Step* findStep(int stepId) const;
+    const StepResult& getResult(int stepId) const;
+    const StepResult& getResultAt(size_t index) const { return states[index].result; }
+    const Step& getStepAt(size_t index) const { return *steps[index]; }
+
+    // Apelata la sfarsitul rularii: un context inactiv nu mai tine continutul fisierelor,
+    // deci ce elibereaza MemoryBudget este chiar eliberat (bufferele proprii raman pentru rularea urmatoare)
+    void releaseResults() {
+        for (auto& state : states) {
+            state.result.text.reset();
+            state.result.table.reset();
+        }
+    }
+    double getNumber(int stepId) const;
+
+    double getNumberAt(size_t index) const {
+        const StepResult& result = states[index].result;
+        if (result.kind != StepResult::NUMBER) {
+            throw runtime_error("Step at position " + to_string(index + 1) + " has no number result.");
+        }
+        return result.number;
+    }
+
+    void publishNumber(size_t index, double value) {
+        StepResult& result = beginPublish(index);
+        result.kind = StepResult::NUMBER;
+        result.number = value;
+    }
+
+    // Numar insotit de textul scris de pas in getTextBuffer (ex: sumarul unui fisier citit in flux)
+    void publishNumberWithText(size_t index, double value) {
+        StepResult& result = beginPublish(index);
+        result.kind = StepResult::NUMBER;
+        result.number = value;
+        result.text = states[index].ownedText;
+    }
+
+    void publishText(size_t index, const string& value) {
+        StepResult& result = beginPublish(index);
+        result.kind = StepResult::TEXT;
+        result.text = copyText(index, value);
+    }
+
+    // Publica textul scris de pas in getTextBuffer
+    void publishTextBuffer(size_t index) {
+        StepResult& result = beginPublish(index);
+        result.kind = StepResult::TEXT;
+        result.text = states[index].ownedText;
+    }
+
+    void publishText(size_t index, shared_ptr<const string> value) {
+        StepResult& result = beginPublish(index);
+        result.kind = StepResult::TEXT;
+        result.text = move(value);
+    }
+
+    void publishTable(size_t index, shared_ptr<const CsvTable> table, shared_ptr<const string> text) {
+        StepResult& result = beginPublish(index);
+        result.kind = StepResult::TABLE;
+        result.table = move(table);
+        result.text = move(text);
+    }
+
+    void incrementErrorCount(size_t index) { states[index].errorCount++; }
+    void incrementSkippedCount(size_t index) { states[index].skippedCount++; }
+    void incrementCompletedCount(size_t index) { states[index].completedCount++; }
+    void incrementTimedOutCount(size_t index) { states[index].timedOutCount++; }
+    int getErrorCount(size_t index) const { return states[index].errorCount; }
+    int getSkippedCount(size_t index) const { return states[index].skippedCount; }
+    int getCompletedCount(size_t index) const { return states[index].completedCount; }
+    int getTimedOutCount(size_t index) const { return states[index].timedOutCount; }
+
+    // Buffer-ul pasului, refolosit intre rulari: dupa prima rulare textele de aceeasi marime nu mai aloca
+    string& getTextBuffer(size_t index) {
+        StepState& state = states[index];
+        if (!state.ownedText || state.ownedText.use_count() > 1) {
+            state.ownedText = make_shared<string>();
+        }
+        return *state.ownedText;
+    }
+
+private:
+    shared_ptr<const string> copyText(size_t index, const string& value) {
+        getTextBuffer(index) = value;
+        return states[index].ownedText;
+    }
+
+    StepResult& beginPublish(size_t index) {
+        StepResult& result = states[index].result;
+        if (result.kind != StepResult::NONE) {
+            throw logic_error("Step result already published.");
+        }
+        return result;
+    }
+};
+
+//clasa pentru evidenta memoriei ocupate de continutul incarcat (fisiere)
+//cand se depaseste limita, continutul folosit cel mai demult este eliberat
+class ReloadableContent;
+
+class MemoryBudget {
+private:
+    size_t limit; // 0 inseamna fara limita
+    size_t usage;
+    int evictionCount;
+    list<ReloadableContent*> recentlyUsed; // primul element este cel mai recent folosit
+    mutex budgetMutex;
+
+    MemoryBudget() : limit(0), usage(0), evictionCount(0) {}
+
+public:
+    static MemoryBudget& instance() {
+        static MemoryBudget budget;
+        return budget;
+    }
+
+    MemoryBudget(const MemoryBudget&) = delete;
+    MemoryBudget& operator=(const MemoryBudget&) = delete;
+
+    void setLimit(size_t limitValue);
+    size_t getLimit() const { return limit; }
+
+    // In procesul copil dupa fork() mutex-ul poate fi ramas blocat de alt thread
+    void resetAfterFork() { new (&budgetMutex) mutex(); }
+    size_t getUsage() const { return usage; }
+    int getEvictionCount() const { return evictionCount; }
+
+    void charge(ReloadableContent* content, size_t bytes, bool reloadable);
+    void touch(ReloadableContent* content);
+    void release(ReloadableContent* content);
+
+    void displayUsage() const {
+        cout << "Memory usage (all flows): " << usage << " bytes";
+        if (limit > 0) {
+            cout << " of " << limit << " bytes budget";
+        }
+        cout << endl;
+        cout << "Evicted contents: " << evictionCount << endl;
+    }
+
+private:
+    void evictOverLimit(ReloadableContent* keep);
+};
+
+//clasa pentru continutul unui fisier care poate fi eliberat si reincarcat la nevoie
+class ReloadableContent {
+private:
+    // Textul fisierului si, pentru CSV, tabelul cu celulele lui
+    struct FileData {
+        string text;
+        CsvTable table;
+    };
+
+    string fileName;
+    bool parseTable;
+    mutable shared_ptr<const FileData> data;
+    bool reloadable;
+    mutable mutex contentMutex;
+
+    // Campuri folosite doar de MemoryBudget, sub lock-ul lui
+    size_t chargedBytes;
+    bool inRecentlyUsed;
+    list<ReloadableContent*>::iterator recentlyUsedPosition;
+    friend class MemoryBudget;
+
+public:
+    ReloadableContent(string fileNameValue, bool parseTableValue = false)
+        : fileName(move(fileNameValue)), parseTable(parseTableValue), reloadable(true), chargedBytes(0), inRecentlyUsed(false) {}
+
+    // La copiere se pastreaza doar numele fisierului, continutul se incarca la prima folosire
+    ReloadableContent(const ReloadableContent& other)
+        : fileName(other.fileName), parseTable(other.parseTable), reloadable(true), chargedBytes(0), inRecentlyUsed(false) {}
+
+    ReloadableContent& operator=(const ReloadableContent&) = delete;
+
+    ~ReloadableContent() {
+        MemoryBudget::instance().release(this);
+    }
+
+    // Intoarce continutul, reincarcand fisierul daca a fost eliberat
+    shared_ptr<const string> get() const {
+        shared_ptr<const FileData> fileData = getData();
+        return shared_ptr<const string>(fileData, &fileData->text);
+    }
+
+    // Textul si tabelul din aceeasi incarcare a fisierului
+    shared_ptr<const string> get(shared_ptr<const CsvTable>& table) const {
+        shared_ptr<const FileData> fileData = getData();
+        table = shared_ptr<const CsvTable>(fileData, &fileData->table);
+        return shared_ptr<const string>(fileData, &fileData->text);
+    }
+
+    // Continut setat direct; nu poate fi reincarcat, deci nu este eliberat
+    void set(string value) {
+        shared_ptr<FileData> newData = make_shared<FileData>();
+        newData->text = move(value);
+        if (parseTable) {
+            parse(*newData);
+        }
+        size_t bytes = sizeOf(*newData);
+        {
+            lock_guard<mutex> lock(contentMutex);
+            data = newData;
+            reloadable = false;
+        }
+        MemoryBudget::instance().charge(this, bytes, false);
+    }
+
+    void setFileName(string fileNameValue) {
+        MemoryBudget::instance().release(this);
+        lock_guard<mutex> lock(contentMutex);
+        fileName = move(fileNameValue);
+        data.reset();
+        reloadable = true;
+    }
+
+    size_t getMemoryUsage() const {
+        lock_guard<mutex> lock(contentMutex);
+        return data ? sizeOf(*data) : 0;
+    }
+
+private:
+    shared_ptr<const FileData> getData() const {
+        shared_ptr<const FileData> result;
+        bool loaded = false;
+        {
+            lock_guard<mutex> lock(contentMutex);
+            if (!data) {
+                data = readFile();
+                loaded = true;
+            }
+            result = data;
+        }
+        ReloadableContent* self = const_cast<ReloadableContent*>(this);
+        if (loaded) {
+            MemoryBudget::instance().charge(self, sizeOf(*result), true);
+        } else {
+            MemoryBudget::instance().touch(self);
+        }
+        return result;
+    }
+
+    // Apelata de MemoryBudget; cititorii care au deja continutul il pastreaza pana termina
+    bool tryEvict() {
+        unique_lock<mutex> lock(contentMutex, try_to_lock);
+        if (!lock.owns_lock() || !reloadable) {
+            return false;
+        }
+        data.reset();
+        return true;
+    }
+
+    shared_ptr<const FileData> readFile() const {
+        ifstream fileStream(fileName);
+        if (!fileStream.is_open()) {
+            throw runtime_error("Unable to open file - " + fileName);
+        }
+        shared_ptr<FileData> fileData = make_shared<FileData>();
+        string line;
+        while (getline(fileStream, line)) {
+            fileData->text += line;
+            fileData->text += '\n';
+        }
+        if (parseTable) {
+            parse(*fileData);
+        }
+        return fileData;
+    }
+
+    // Imparte textul in randuri si celule separate prin virgula
+    static void parse(FileData& fileData) {
+        string_view text = fileData.text;
+        while (!text.empty()) {
+            size_t lineEnd = text.find('\n');
+            string_view line = text.substr(0, lineEnd);
+            vector<string_view> row;
+            size_t cellStart = 0;
+            while (true) {
+                size_t comma = line.find(',', cellStart);
+                row.push_back(line.substr(cellStart, comma == string_view::npos ? string_view::npos : comma - cellStart));
+                if (comma == string_view::npos) {
+                    break;
+                }
+                cellStart = comma + 1;
+            }
+            fileData.table.push_back(move(row));
+            text = lineEnd == string_view::npos ? string_view() : text.substr(lineEnd + 1);
+        }
+    }
+
+    static size_t sizeOf(const FileData& fileData) {
+        size_t bytes = fileData.text.capacity() + fileData.table.capacity() * sizeof(vector<string_view>);
+        for (const auto& row : fileData.table) {
+            bytes += row.capacity() * sizeof(string_view);
+        }
+        return bytes;
+    }
+};
+
+inline void MemoryBudget::setLimit(size_t limitValue) {
+    lock_guard<mutex> lock(budgetMutex);
+    limit = limitValue;
+    evictOverLimit(nullptr);
+}
+
+inline void MemoryBudget::charge(ReloadableContent* content, size_t bytes, bool reloadable) {
+    lock_guard<mutex> lock(budgetMutex);
+    usage = usage - content->chargedBytes + bytes;
+    content->chargedBytes = bytes;
+    if (content->inRecentlyUsed) {
+        recentlyUsed.erase(content->recentlyUsedPosition);
+        content->inRecentlyUsed = false;
+    }
+    if (reloadable) {
+        recentlyUsed.push_front(content);
+        content->recentlyUsedPosition = recentlyUsed.begin();
+        content->inRecentlyUsed = true;
+    }
+    evictOverLimit(content);
+}
+
+inline void MemoryBudget::touch(ReloadableContent* content) {
+    lock_guard<mutex> lock(budgetMutex);
+    if (content->inRecentlyUsed) {
+        recentlyUsed.splice(recentlyUsed.begin(), recentlyUsed, content->recentlyUsedPosition);
+    }
+}
+
+inline void MemoryBudget::release(ReloadableContent* content) {
+    lock_guard<mutex> lock(budgetMutex);
+    usage -= content->chargedBytes;
+    content->chargedBytes = 0;
+    if (content->inRecentlyUsed) {
+        recentlyUsed.erase(content->recentlyUsedPosition);
+        content->inRecentlyUsed = false;
+    }
+}
+
+// Elibereaza continutul folosit cel mai demult pana revenim sub limita
+inline void MemoryBudget::evictOverLimit(ReloadableContent* keep) {
+    if (limit == 0) {
+        return;
+    }
+    auto it = recentlyUsed.end();
+    while (usage > limit && it != recentlyUsed.begin()) {
+        --it;
+        ReloadableContent* victim = *it;
+        if (victim == keep || !victim->tryEvict()) {
+            continue;
+        }
+        usage -= victim->chargedBytes;
+        victim->chargedBytes = 0;
+        victim->inRecentlyUsed = false;
+        it = recentlyUsed.erase(it);
+        evictionCount++;
+    }
+}
+
 //clasa abstracta pentru Step
 class Step {
 private:
     string stepType;
+    int id;       // ID stabil in flow, folosit de pasii care refera acest pas
+    size_t index; // pozitia in flow, folosita pentru starea din RunContext
+    int deadlineMs; // 0 inseamna fara deadline
     int errorCount;
     int skippedCount;
     int completedCount;
+    int timedOutCount;
+    AllocationCounter* allocationCounter; // alocarile tuturor pasilor de acest tip
 
 public:
-    Step(const string& type) : stepType(type), errorCount(0), skippedCount(0), completedCount(0) {}
+    Step(string type)
+        : stepType(move(type)), id(0), index(0), deadlineMs(0), errorCount(0), skippedCount(0), completedCount(0), timedOutCount(0),
+          allocationCounter(AllocationTracker::instance().counterFor(stepType)) {}
 
-    virtual void execute() = 0;
-    virtual void print() const = 0;
+    // Pasii sunt read-only in timpul rularii, starea se scrie in RunContext
+    virtual void execute(RunContext& context) const = 0;
+    // Afiseaza rezultatul publicat in stream-ul primit (consola sau fisierul unui OutputStep)
+    virtual void print(const RunContext& context, ostream& output) const = 0;
+
+    // Memoria ocupata de continutul incarcat al pasului (fisiere)
+    virtual size_t getMemoryUsage() const { return 0; }
 
     void incrementErrorCount() { errorCount++; } 
     void incrementSkippedCount() { skippedCount++; }
@@ -32,22 +882,72 @@ public:
     void displayErrors() const { cout << "Errors: " << errorCount << endl; } 
     void displaySkippedCount() const { cout << "Skipped: " << skippedCount << endl; } 
     void displayCompletedCount() const { cout << "Completed: " << completedCount << endl; }
+    void displayTimedOutCount() const { cout << "Timed out: " << timedOutCount << endl; }
 
 
     int getErrorCount() const { return errorCount; }
     int getSkippedCount() const { return skippedCount; }
     int getCompletedCount() const { return completedCount; }
+    int getTimedOutCount() const { return timedOutCount; }
+    int getDeadlineMs() const { return deadlineMs; }
 
     const string& getStepType() const { return stepType; }
-    void setStepType(const string& type) { stepType = type; }
+    AllocationCounter* getAllocationCounter() const { return allocationCounter; }
+    int getId() const { return id; }
+    void setId(int idValue) { id = idValue; }
+    size_t getIndex() const { return index; }
+    void setIndex(size_t indexValue) { index = indexValue; }
+    void setStepType(string type) {
+        stepType = move(type);
+        allocationCounter = AllocationTracker::instance().counterFor(stepType);
+    }
     void setErrorCount(int count) { errorCount = count; }
     void setSkippedCount(int count) { skippedCount = count; }
     void setCompletedCount(int count) { completedCount = count; }
+    void setTimedOutCount(int count) { timedOutCount = count; }
+    void setDeadlineMs(int deadlineMsValue) { deadlineMs = deadlineMsValue; }
 
     //destructor
     virtual ~Step() {}
+
+protected:
+    // Pasul sursa se cauta dupa ID la fiecare rulare, deci nu ramane o referinta invalida
+    static const Step& findSourceStep(const RunContext& context, int sourceStepId);
 };
 
+inline const Step* RunContext::findStep(int stepId) const {
+    for (const Step* step : steps) {
+        if (step->getId() == stepId) {
+            return step;
+        }
+    }
+    return nullptr;
+}
+
+inline const Step& Step::findSourceStep(const RunContext& context, int sourceStepId) {
+    const Step* step = context.findStep(sourceStepId);
+    if (step == nullptr) {
+        throw runtime_error("Source step " + to_string(sourceStepId) + " not found in the flow.");
+    }
+    return *step;
+}
+
+inline const StepResult& RunContext::getResult(int stepId) const {
+    const Step* step = findStep(stepId);
+    if (step == nullptr) {
+        throw runtime_error("Step " + to_string(stepId) + " not found in the flow.");
+    }
+    return states[step->getIndex()].result;
+}
+
+inline double RunContext::getNumber(int stepId) const {
+    const StepResult& result = getResult(stepId);
+    if (result.kind != StepResult::NUMBER) {
+        throw runtime_error("Step " + to_string(stepId) + " has no number result.");
+    }
+    return result.number;
+}
+
 //clasa pentru TitleStep
 class TitleStep : public Step {
 private:
@@ -55,26 +955,28 @@ private:
     string subtitle;
 
 public:
-    TitleStep(const string& titleValue, const string& subtitleValue)
-        : Step("TITLE"), title(titleValue), subtitle(subtitleValue) {}
-
-    void execute() override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Title: " << title << endl;
-        cout << "   Subtitle: " << subtitle << endl;
-        cout << "------------------------------------" << endl;
+    TitleStep(string titleValue, string subtitleValue)
+        : Step("TITLE"), title(move(titleValue)), subtitle(move(subtitleValue)) {}
+
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        context.publishText(getIndex(), title);
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Title: " << title << endl;
+        output << "   Subtitle: " << subtitle << endl;
+        output << "------------------------------------" << endl;
     }
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Title: " << title << endl;
-        cout << "   Subtitle: " << subtitle << endl;
-        cout << "------------------------------------" << endl;
+    void print(const RunContext&, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Title: " << title << endl;
+        output << "   Subtitle: " << subtitle << endl;
+        output << "------------------------------------" << endl;
     }
 
     const string& getTitle() const { return title; }
     const string& getSubtitle() const { return subtitle; }
-    void setTitle(const string& titleValue) { title = titleValue; }
-    void setSubtitle(const string& subtitleValue) { subtitle = subtitleValue; }
+    void setTitle(string titleValue) { title = move(titleValue); }
+    void setSubtitle(string subtitleValue) { subtitle = move(subtitleValue); }
 };
 //clasa pentru TextStep
 class TextStep : public Step {
@@ -83,170 +985,579 @@ private:
     string copy;
 
 public:
-    TextStep(const string& titleValue, const string& copyValue)
-        : Step("TEXT"), title(titleValue), copy(copyValue) {}
-    void execute() override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Title: " << title << endl;
-        cout << "   Copy: " << copy << endl;
-        cout << "------------------------------------" << endl;
+    TextStep(string titleValue, string copyValue)
+        : Step("TEXT"), title(move(titleValue)), copy(move(copyValue)) {}
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        context.publishText(getIndex(), copy);
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Title: " << title << endl;
+        output << "   Copy: " << copy << endl;
+        output << "------------------------------------" << endl;
     }
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Title: " << title << endl;
-        cout << "   Copy: " << copy << endl;
-        cout << "------------------------------------" << endl;
+    void print(const RunContext&, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Title: " << title << endl;
+        output << "   Copy: " << copy << endl;
+        output << "------------------------------------" << endl;
     }
 
     const string& getTitle() const { return title; }
     const string& getCopy() const { return copy; }
-    void setTitle(const string& titleValue) { title = titleValue; }
-    void setCopy(const string& copyValue) { copy = copyValue; }
+    void setTitle(string titleValue) { title = move(titleValue); }
+    void setCopy(string copyValue) { copy = move(copyValue); }
 };
 
 //clasa pentru TextInputStep
 class TextInputStep : public Step {
 private:
     string description;
-    string userInput;
 
 public:
-    TextInputStep(const string& descriptionValue)
-        : Step("TEXT_INPUT"), description(descriptionValue) {}
+    TextInputStep(string descriptionValue)
+        : Step("TEXT_INPUT"), description(move(descriptionValue)) {}
 
-    void execute() override {
+    void execute(RunContext& context) const override {
+        istream& input = context.getInput();
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
         try {
-            cout << "Step Type: " << getStepType() << endl;
-            cout << "   Description: " << description << endl;
-            cout << "   Enter text: ";
-            cin.ignore();
-            string input;
-            getline(cin, input);
-            setUserInput(input);
-            cout << "   User Input: " << getUserInput() << endl;
-            cout << "------------------------------------" << endl;
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Description: " << description << endl;
+            output << "   Enter text: ";
+            waitForInput(input, context.getCancellationToken(), true);
+            getline(input, context.getTextBuffer(getIndex())); // citit direct in buffer-ul refolosit
+            context.publishTextBuffer(getIndex());
+            output << "   User Input: " << getUserInput(context) << endl;
+            output << "------------------------------------" << endl;
+        } catch (const StepCancelled&) {
+            throw; // tratat de Flow ca timeout
         } catch (const exception& e) {
-            incrementErrorCount();
-            cerr << "Error: " << e.what() << endl;
+            context.incrementErrorCount(getIndex());
+            errors << "Error: " << e.what() << endl;
         }
     }
 
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Description: " << description << endl;
-        cout << "   User Input: " << getUserInput() << endl;
-        cout << "------------------------------------" << endl;
+    void print(const RunContext& context, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Description: " << description << endl;
+        output << "   User Input: " << getUserInput(context) << endl;
+        output << "------------------------------------" << endl;
     }
 
     const string& getDescription() const { return description; }
-    const string& getUserInput() const { return userInput; }
-    void setDescription(const string& descriptionValue) { description = descriptionValue; }
-    void setUserInput(const string& userInputValue) { userInput = userInputValue; }
+    const string& getUserInput(const RunContext& context) const {
+        static const string noInput;
+        const StepResult& result = context.getResultAt(getIndex());
+        return result.text ? *result.text : noInput;
+    }
+    void setDescription(string descriptionValue) { description = move(descriptionValue); }
 };
 //clasa pentru NumberInputStep
 class NumberInputStep : public Step {
 private:
     string description;
-    double userInput;
 
 public:
-    void execute() override {
+    void execute(RunContext& context) const override {
+        istream& input = context.getInput();
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
         try {
-            cout << "Step Type: " << getStepType() << endl;
-            cout << "   Description: " << description << endl;
-            cout << "   Enter a number: ";
-            double input;
-            cin >> input;
-            setUserInput(input);
-            cout << "   User Input: " << getUserInput() << endl;
-            cout << "------------------------------------" << endl;
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Description: " << description << endl;
+            output << "   Enter a number: ";
+            waitForInput(input, context.getCancellationToken());
+            double value = readNumber(input, context.getTextBuffer(getIndex()));
+            context.publishNumber(getIndex(), value);
+            output << "   User Input: " << getUserInput(context) << endl;
+            output << "------------------------------------" << endl;
+        } catch (const StepCancelled&) {
+            throw; // tratat de Flow ca timeout
         } catch (const exception& e) {
             if(e.what() == string("basic_ios::clear")) {
-                cerr << "Error: Invalid input." << endl;
+                errors << "Error: Invalid input." << endl;
             } else {
-                cerr << "Error: " << e.what() << endl;
+                errors << "Error: " << e.what() << endl;
             }
-            incrementErrorCount();
+            context.incrementErrorCount(getIndex());
         }
     }
 
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Description: " <<description << endl;
-        cout << "   User Input: " << userInput << endl;
-        cout << "------------------------------------" << endl;
+    void print(const RunContext& context, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Description: " <<description << endl;
+        output << "   User Input: " << getUserInput(context) << endl;
+        output << "------------------------------------" << endl;
     }
 
-    NumberInputStep(const string& descriptionValue) : Step("NUMBER_INPUT"), description(descriptionValue) {}
+    NumberInputStep(string descriptionValue) : Step("NUMBER_INPUT"), description(move(descriptionValue)) {}
     const string& getDescription() const { return description; }
-    double getUserInput() const { return userInput; }
-    void setDescription(const string& descriptionValue) { description = descriptionValue; }
-    void setUserInput(double userInputValue) { userInput = userInputValue; }
-    
-};
-//clasa pentru CalculusStep
+    double getUserInput(const RunContext& context) const { return context.getResultAt(getIndex()).number; }
+    void setDescription(string descriptionValue) { description = move(descriptionValue); }
+
+private:
+    // Metoda pentru citirea numarului; cin >> double aloca un buffer la fiecare citire,
+    // asa ca textul este citit in buffer-ul pasului si convertit cu strtod
+    static double readNumber(istream& input, string& token) {
+        input >> token;
+        char* end = nullptr;
+        double value = strtod(token.c_str(), &end);
+        if (token.empty() || end != token.c_str() + token.size()) {
+            input.setstate(ios::failbit); // la fel ca operatorul >> pentru un numar invalid
+            return 0;
+        }
+        return value;
+    }
+};
+// Operatiile unui CalculusStep; textul operatiei este convertit o singura data, nu la fiecare rulare
+enum CalculusOperation {
+    OPERATION_ADD,
+    OPERATION_SUBTRACT,
+    OPERATION_MULTIPLY,
+    OPERATION_DIVIDE,
+    OPERATION_MIN,
+    OPERATION_MAX,
+    OPERATION_INVALID
+};
+
+//clasa pentru CalculusStep
 class CalculusStep : public Step {
 private:
-    const NumberInputStep& operand1;
-    const NumberInputStep& operand2;
+    int operand1Id;
+    int operand2Id;
     string operation;
-    double result;
+    CalculusOperation operationCode;
 
 public:
-    CalculusStep(const NumberInputStep& operand1Value,const NumberInputStep& operand2Value, const string& operationValue)
-        : Step("CALCULUS"), operand1(operand1Value), operand2(operand2Value), operation(operationValue) {}
+    CalculusStep(int operand1IdValue, int operand2IdValue, string operationValue)
+        : Step("CALCULUS"), operand1Id(operand1IdValue), operand2Id(operand2IdValue), operation(move(operationValue)),
+          operationCode(parseOperation(operation)) {}
 
-    void execute() override {
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
         try {
-            cout << "Step Type: " << getStepType() << endl;
-            cout << "   Operation: " << operand1.getUserInput() << " " << operation << " " << operand2.getUserInput() << endl;
-            double r;
-            //selectarea operatiei
-            if (operation == "+") {
-                r = operand1.getUserInput() + operand2.getUserInput();
-            } else if (operation == "-") {
-                r = operand1.getUserInput() - operand2.getUserInput();
-            } else if (operation == "*") {
-                r = operand1.getUserInput() * operand2.getUserInput();
-            } else if (operation == "/") {
+            double value1 = context.getNumber(operand1Id);
+            double value2 = context.getNumber(operand2Id);
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Operation: " << value1 << " " << operation << " " << value2 << endl;
+            double r = calculate(value1, value2, operationCode);
+            context.publishNumber(getIndex(), r);
+            output << "   Result: " << r << endl;
+            output << "------------------------------------" << endl;
+        } catch (const exception& e) {
+            if(e.what() == "basic_ios::clear") {
+                errors << "Error: Invalid input." << endl;
+            } else {
+                errors << "Error: " << e.what() << endl;
+            }
+            context.incrementErrorCount(getIndex());
+        }
+    }
+
+    static CalculusOperation parseOperation(const string& operation) {
+        if (operation == "+") {
+            return OPERATION_ADD;
+        } else if (operation == "-") {
+            return OPERATION_SUBTRACT;
+        } else if (operation == "*") {
+            return OPERATION_MULTIPLY;
+        } else if (operation == "/") {
+            return OPERATION_DIVIDE;
+        } else if (operation == "min") {
+            return OPERATION_MIN;
+        } else if (operation == "max") {
+            return OPERATION_MAX;
+        }
+        return OPERATION_INVALID; // eroarea este raportata la rulare, ca inainte
+    }
+
+    static constexpr const char* operationSymbol(CalculusOperation operation) {
+        switch (operation) {
+            case OPERATION_ADD: return "+";
+            case OPERATION_SUBTRACT: return "-";
+            case OPERATION_MULTIPLY: return "*";
+            case OPERATION_DIVIDE: return "/";
+            case OPERATION_MIN: return "min";
+            case OPERATION_MAX: return "max";
+            default: return "?";
+        }
+    }
+
+    // Metoda pentru calculul rezultatului, folosita si de StaticCalculusStep (acolo operatia este constanta)
+    static double calculate(double value1, double value2, CalculusOperation operation) {
+        double r;
+        //selectarea operatiei
+        switch (operation) {
+            case OPERATION_ADD:
+                r = value1 + value2;
+                break;
+            case OPERATION_SUBTRACT:
+                r = value1 - value2;
+                break;
+            case OPERATION_MULTIPLY:
+                r = value1 * value2;
+                break;
+            case OPERATION_DIVIDE:
                 //caz de exceptie pentru impartirea la 0
-                if (operand2.getUserInput() != 0) {
-                    r = operand1.getUserInput() / operand2.getUserInput();
+                if (value2 != 0) {
+                    r = value1 / value2;
                 } else {
                     throw runtime_error("Division by zero.");
                 }
-            } else if (operation == "min") {
-                r = min(operand1.getUserInput(), operand2.getUserInput());
-            } else if (operation == "max") {
-                r = max(operand1.getUserInput(), operand2.getUserInput());
-            } else {
+                break;
+            case OPERATION_MIN:
+                r = min(value1, value2);
+                break;
+            case OPERATION_MAX:
+                r = max(value1, value2);
+                break;
+            default:
                 throw invalid_argument("Invalid operation.");
-            }
-            result = r;
-            cout << "   Result: " << result << endl;
-            cout << "------------------------------------" << endl;
+        }
+        return r;
+    }
+
+    void print(const RunContext& context, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        try {
+            output << "   Operation: " << context.getResult(operand1Id).number << " " << operation << " "
+                 << context.getResult(operand2Id).number << endl;
         } catch (const exception& e) {
-            if(e.what() == "basic_ios::clear") {
-                cerr << "Error: Invalid input." << endl;
-            } else {
-                cerr << "Error: " << e.what() << endl;
+            output << "   Operation: " << e.what() << endl;
+        }
+        output << "   Result: " << getResult(context) << endl;
+        output << "------------------------------------" << endl;
+    }
+    int getOperand1Id() const { return operand1Id; }
+    int getOperand2Id() const { return operand2Id; }
+    const string& getOperation() const { return operation; }
+    double getResult(const RunContext& context) const { return context.getResultAt(getIndex()).number; }
+    void setOperation(string operationValue) {
+        operation = move(operationValue);
+        operationCode = parseOperation(operation);
+    }
+};
+
+//clasa pentru CalculusStep intr-un StaticFlow
+//operanzii sunt indecsi de pasi cunoscuti la compilare si verificati de StaticFlow,
+//iar operatia este si ea fixata la compilare, deci rularea nu compara stringuri
+template <size_t Operand1, size_t Operand2, CalculusOperation Operation>
+class StaticCalculusStep : public Step {
+public:
+    static_assert(Operation != OPERATION_INVALID, "Invalid calculus operation.");
+
+    static constexpr size_t operand1 = Operand1;
+    static constexpr size_t operand2 = Operand2;
+
+    StaticCalculusStep() : Step("CALCULUS") {}
+
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
+        try {
+            double value1 = context.getNumberAt(Operand1);
+            double value2 = context.getNumberAt(Operand2);
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Operation: " << value1 << " " << getOperation() << " " << value2 << endl;
+            double r = CalculusStep::calculate(value1, value2, Operation);
+            context.publishNumber(getIndex(), r);
+            output << "   Result: " << r << endl;
+            output << "------------------------------------" << endl;
+        } catch (const exception& e) {
+            errors << "Error: " << e.what() << endl;
+            context.incrementErrorCount(getIndex());
+        }
+    }
+
+    void print(const RunContext& context, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Operation: " << context.getResultAt(Operand1).number << " " << getOperation() << " "
+             << context.getResultAt(Operand2).number << endl;
+        output << "   Result: " << getResult(context) << endl;
+        output << "------------------------------------" << endl;
+    }
+
+    static constexpr const char* getOperation() { return CalculusStep::operationSymbol(Operation); }
+    double getResult(const RunContext& context) const { return context.getResultAt(getIndex()).number; }
+};
+
+template <typename StepType>
+struct IsStaticCalculusStep : false_type {};
+
+template <size_t Operand1, size_t Operand2, CalculusOperation Operation>
+struct IsStaticCalculusStep<StaticCalculusStep<Operand1, Operand2, Operation>> : true_type {};
+
+//optiuni pentru citirea in flux a unui fisier text, fara sa fie tinut in memorie
+struct StreamOptions {
+    string pattern; // liniile care contin textul sunt numarate, ca la grep -c
+    int headLines;  // cate linii de la inceput sunt pastrate
+    int tailLines;  // cate linii de la sfarsit sunt pastrate
+
+    StreamOptions() : headLines(0), tailLines(0) {}
+};
+
+//rezultatul citirii in flux
+//head si tail arata in bufferele thread-ului care a citit si raman valabile pana la urmatoarea citire din el
+struct StreamSummary {
+    long long byteCount;
+    long long lineCount;
+    long long matchCount;
+    string_view head;
+    string_view tail;
+
+    StreamSummary() : byteCount(0), lineCount(0), matchCount(0) {}
+};
+
+//clasa pentru parcurgerea unui fisier text in bucati de dimensiune fixa
+//memoria folosita nu depinde de marimea fisierului
+class TextFileScanner {
+public:
+    static const size_t chunkSize = 64 * 1024;
+    static const size_t maxLineLength = 1024; // liniile pastrate pentru head/tail sunt trunchiate
+
+    TextFileScanner(const StreamOptions& optionsValue)
+        : options(optionsValue), buffers(threadBuffers()), lineMatched(false), lineOpen(false), headCount(0) {
+        buffers.currentLine.clear();
+        buffers.carry.clear();
+        buffers.head.clear();
+        buffers.tail.clear();
+        buffers.chunk.resize(chunkSize);
+    }
+
+    // Token-ul este verificat dupa fiecare bucata citita
+    StreamSummary scan(const string& fileName, const CancellationToken& token) {
+        // Cu un buffer dat de noi ifstream nu aloca; bucatile mari sunt citite direct in chunk
+        char streamBuffer[256];
+        ifstream fileStream;
+        fileStream.rdbuf()->pubsetbuf(streamBuffer, sizeof(streamBuffer));
+        fileStream.open(fileName, ios::binary);
+        if (!fileStream.is_open()) {
+            throw runtime_error("Unable to open file - " + fileName);
+        }
+
+        vector<char>& buffer = buffers.chunk;
+        bool needLines = !options.pattern.empty() || options.headLines > 0;
+        while (fileStream) {
+            fileStream.read(buffer.data(), buffer.size());
+            size_t size = static_cast<size_t>(fileStream.gcount());
+            if (size == 0) {
+                break;
             }
-            incrementErrorCount();
+            summary.byteCount += size;
+            token.throwIfCancelled();
+
+            // Fara cautare si cu head-ul complet ajunge sa numaram liniile
+            if (!needLines) {
+                summary.lineCount += countNewlines(buffer.data(), size);
+                lineOpen = buffer[size - 1] != '\n';
+                continue;
+            }
+
+            const char* data = buffer.data();
+            const char* end = data + size;
+            while (data < end) {
+                const char* newline = static_cast<const char*>(memchr(data, '\n', end - data));
+                const char* segmentEnd = newline != nullptr ? newline : end;
+                appendSegment(data, segmentEnd - data);
+                if (newline != nullptr) {
+                    endLine();
+                    data = newline + 1;
+                } else {
+                    data = end;
+                }
+            }
+            needLines = !options.pattern.empty() || headCount < options.headLines;
+        }
+        if (lineOpen) {
+            endLine(); // ultima linie fara '\n' la final
         }
+        summary.head = buffers.head;
+        if (options.tailLines > 0) {
+            readTail(fileName);
+            summary.tail = buffers.tail;
+        }
+        return summary;
     }
 
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Operation: " << operand1.getUserInput() << " " << operation << " " << operand2.getUserInput() << endl;
-        cout << "   Result: " << result << endl;
-        cout << "------------------------------------" << endl;
+    // Numara caracterele '\n', cate 16 octeti odata cu SSE2
+    static size_t countNewlines(const char* data, size_t size) {
+        size_t count = 0;
+        size_t i = 0;
+#ifdef FLOW_HAVE_SSE2
+        const __m128i newline = _mm_set1_epi8('\n');
+        for (; i + 16 <= size; i += 16) {
+            __m128i block = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            count += bitset<16>(_mm_movemask_epi8(_mm_cmpeq_epi8(block, newline))).count();
+        }
+#endif
+        for (; i < size; ++i) {
+            count += data[i] == '\n';
+        }
+        return count;
+    }
+
+    // Cauta textul: SSE2 compara primul si ultimul caracter pe 16 pozitii odata,
+    // iar memcmp verifica doar pozitiile candidate
+    static const char* findPattern(const char* data, size_t size, const string& pattern) {
+        size_t length = pattern.size();
+        if (length == 0 || size < length) {
+            return nullptr;
+        }
+        size_t i = 0;
+#ifdef FLOW_HAVE_SSE2
+        const __m128i first = _mm_set1_epi8(pattern[0]);
+        const __m128i last = _mm_set1_epi8(pattern[length - 1]);
+        for (; i + length - 1 + 16 <= size; i += 16) {
+            __m128i blockFirst = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i));
+            __m128i blockLast = _mm_loadu_si128(reinterpret_cast<const __m128i*>(data + i + length - 1));
+            unsigned mask = _mm_movemask_epi8(_mm_and_si128(_mm_cmpeq_epi8(blockFirst, first),
+                                                            _mm_cmpeq_epi8(blockLast, last)));
+            for (size_t bit = 0; mask != 0; ++bit, mask >>= 1) {
+                if ((mask & 1) != 0 && memcmp(data + i + bit, pattern.data(), length) == 0) {
+                    return data + i + bit;
+                }
+            }
+        }
+#endif
+        for (; i + length <= size; ++i) {
+            if (data[i] == pattern[0] && memcmp(data + i, pattern.data(), length) == 0) {
+                return data + i;
+            }
+        }
+        return nullptr;
+    }
+
+private:
+    // Buffere refolosite de toate citirile din acelasi thread, deci citirile repetate nu mai aloca
+    struct Buffers {
+        vector<char> chunk;
+        string currentLine; // inceputul liniei curente, pentru head
+        string carry;       // ultimele caractere ale liniei curente, pentru potriviri intre bucati
+        string boundary;
+        string head;
+        string tail;
+        vector<pair<streamoff, streamoff>> tailLines;
+    };
+
+    static Buffers& threadBuffers() {
+        static thread_local Buffers buffers;
+        return buffers;
+    }
+
+    const StreamOptions& options;
+    Buffers& buffers;
+    StreamSummary summary;
+    bool lineMatched;
+    bool lineOpen;
+    int headCount;
+
+    // Adauga o parte din linia curenta (linia poate continua in bucata urmatoare)
+    void appendSegment(const char* data, size_t size) {
+        if (size == 0) {
+            return;
+        }
+        lineOpen = true;
+        string& currentLine = buffers.currentLine;
+        if (headCount < options.headLines && currentLine.size() < maxLineLength) {
+            currentLine.append(data, min(size, maxLineLength - currentLine.size()));
+        }
+        if (options.pattern.empty() || lineMatched) {
+            return;
+        }
+        size_t keep = options.pattern.size() - 1;
+        string& carry = buffers.carry;
+        if (!carry.empty()) {
+            string& boundary = buffers.boundary;
+            boundary.assign(carry);
+            boundary.append(data, min(size, keep));
+            lineMatched = findPattern(boundary.data(), boundary.size(), options.pattern) != nullptr;
+        }
+        if (!lineMatched) {
+            lineMatched = findPattern(data, size, options.pattern) != nullptr;
+        }
+        if (size >= keep) {
+            carry.assign(data + size - keep, keep);
+        } else {
+            carry.append(data, size);
+            if (carry.size() > keep) {
+                carry.erase(0, carry.size() - keep);
+            }
+        }
+    }
+
+    void endLine() {
+        summary.lineCount++;
+        if (lineMatched) {
+            summary.matchCount++;
+        }
+        if (headCount < options.headLines) {
+            buffers.head += buffers.currentLine;
+            buffers.head += '\n';
+            headCount++;
+        }
+        buffers.currentLine.clear();
+        buffers.carry.clear();
+        lineMatched = false;
+        lineOpen = false;
+    }
+
+    // Citeste doar sfarsitul fisierului: cauta inapoi inceputul ultimelor tailLines linii,
+    // apoi citeste din fiecare cel mult maxLineLength caractere
+    void readTail(const string& fileName) {
+        char streamBuffer[256];
+        ifstream fileStream;
+        fileStream.rdbuf()->pubsetbuf(streamBuffer, sizeof(streamBuffer));
+        fileStream.open(fileName, ios::binary | ios::ate);
+        if (!fileStream.is_open()) {
+            throw runtime_error("Unable to open file - " + fileName);
+        }
+        string& tail = buffers.tail;
+        streamoff fileSize = fileStream.tellg();
+        if (fileSize <= 0) {
+            return; // fisier gol, fara linii
+        }
+
+        // Sfarsitul ultimei linii, fara '\n'-ul final
+        streamoff lineEnd = fileSize;
+        fileStream.seekg(fileSize - 1);
+        if (fileStream.get() == '\n') {
+            lineEnd--;
+        }
+
+        vector<pair<streamoff, streamoff>>& lines = buffers.tailLines; // [inceput, sfarsit), de la ultima linie
+        lines.clear();
+        vector<char>& chunk = buffers.chunk;
+        streamoff position = lineEnd;
+        while (lines.size() < static_cast<size_t>(options.tailLines)) {
+            if (position == 0) {
+                lines.push_back(make_pair(streamoff(0), lineEnd)); // prima linie din fisier
+                break;
+            }
+            streamoff blockStart = position > static_cast<streamoff>(chunkSize) ? position - chunkSize : 0;
+            size_t size = static_cast<size_t>(position - blockStart);
+            fileStream.seekg(blockStart);
+            fileStream.read(chunk.data(), size);
+            for (size_t i = size; i > 0 && lines.size() < static_cast<size_t>(options.tailLines); --i) {
+                if (chunk[i - 1] == '\n') {
+                    streamoff newline = blockStart + static_cast<streamoff>(i - 1);
+                    lines.push_back(make_pair(newline + 1, lineEnd));
+                    lineEnd = newline;
+                }
+            }
+            position = blockStart;
+        }
+
+        for (auto line = lines.rbegin(); line != lines.rend(); ++line) {
+            size_t length = static_cast<size_t>(min(line->second - line->first, static_cast<streamoff>(maxLineLength)));
+            size_t offset = tail.size();
+            tail.resize(offset + length);
+            fileStream.seekg(line->first);
+            fileStream.read(&tail[offset], length);
+            tail += '\n';
+        }
     }
-    const NumberInputStep& getOperand1() const { return operand1; }
-    const NumberInputStep& getOperand2() const { return operand2; }
-    const string& getOperation() const { return operation; }
-    double getResult() const { return result; }
-    void setOperation(const string& operationValue) { operation = operationValue; }
-    void setResult(double resultValue) { result = resultValue; }
 };
 
 //clasa pentru TextFileInputStep
@@ -254,66 +1565,139 @@ class TextFileInputStep : public Step {
 private:
     string description;
     string fileName;
-    string fileContent;
+    ReloadableContent fileContent;
+    bool streaming; // fisierul este parcurs in bucati la fiecare rulare, fara sa fie incarcat
+    StreamOptions streamOptions;
 
 public:
-    TextFileInputStep(const string& descriptionValue, const string& fileNameValue)
-        : Step("TEXT_FILE_INPUT"), description(descriptionValue), fileName(fileNameValue) {
+    TextFileInputStep(string descriptionValue, string fileNameValue)
+        : Step("TEXT_FILE_INPUT"), description(move(descriptionValue)), fileName(move(fileNameValue)), fileContent(fileName),
+          streaming(false) {
         readFileContent();
     }
 
-    void execute() override {
+    TextFileInputStep(string descriptionValue, string fileNameValue, StreamOptions options)
+        : Step("TEXT_FILE_INPUT"), description(move(descriptionValue)), fileName(move(fileNameValue)), fileContent(fileName),
+          streaming(true), streamOptions(move(options)) {}
+
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
+        if (streaming) {
+            executeStreaming(context);
+            return;
+        }
         try {
-            cout << "Step Type: " << getStepType() << endl;
-            cout << "   Description: " << description << endl;
-            cout << "   File Name: " << fileName << endl;
-            cout << "   File Content: " << fileContent << endl;
-            cout << "------------------------------------" << endl;
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Description: " << description << endl;
+            output << "   File Name: " << fileName << endl;
+            context.getCancellationToken().throwIfCancelled();
+            shared_ptr<const string> content = fileContent.get();
+            context.publishText(getIndex(), content);
+            output << "   File Content: " << *content << endl;
+            output << "------------------------------------" << endl;
+        } catch (const StepCancelled&) {
+            throw; // tratat de Flow ca timeout
         } catch (const exception& e) {
             if(e.what() == "basic_ios::clear") {
-                cerr << "Error: Invalid input." << endl;
+                errors << "Error: Invalid input." << endl;
             } else {
-                cerr << "Error: " << e.what() << endl;
+                errors << "Error: " << e.what() << endl;
             }
-            incrementErrorCount();
+            context.incrementErrorCount(getIndex());
         }
     }
 
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Description: " << description << endl;
-        cout << "   File Name: " << fileName << endl;
-        cout << "   File Content: " << fileContent << endl;
-        cout << "------------------------------------" << endl;
+    void print(const RunContext& context, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Description: " << description << endl;
+        output << "   File Name: " << fileName << endl;
+        const StepResult& result = context.getResultAt(getIndex());
+        if (streaming) {
+            if (result.text) {
+                output << *result.text;
+            } else {
+                output << "   No summary for this run." << endl;
+            }
+            output << "------------------------------------" << endl;
+            return;
+        }
+        try {
+            output << "   File Content: " << (result.text ? *result.text : *fileContent.get()) << endl;
+        } catch (const exception& e) {
+            output << "   File Content: " << e.what() << endl;
+        }
+        output << "------------------------------------" << endl;
     }
 
+    size_t getMemoryUsage() const override { return fileContent.getMemoryUsage(); }
+
     const string& getDescription() const { return description; }
     const string& getFileName() const { return fileName; }
-    const string& getFileContent() const { return fileContent; }
-    void setDescription(const string& descriptionValue) { description = descriptionValue; }
-    void setFileName(const string& fileNameValue) { fileName = fileNameValue; }
-    void setFileContent(const string& fileContentValue) { fileContent = fileContentValue; }
+    bool isStreaming() const { return streaming; }
+    const StreamOptions& getStreamOptions() const { return streamOptions; }
+    shared_ptr<const string> getFileContent() const { return fileContent.get(); }
+    void setDescription(string descriptionValue) { description = move(descriptionValue); }
+    void setFileName(string fileNameValue) { fileName = move(fileNameValue); fileContent.setFileName(fileName); }
+    void setFileContent(string fileContentValue) { fileContent.set(move(fileContentValue)); }
 
 private:
+    // Parcurge fisierul in flux si publica numarul de potriviri (sau de linii) si sumarul
+    void executeStreaming(RunContext& context) const {
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
+        try {
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Description: " << description << endl;
+            output << "   File Name: " << fileName << endl;
+            TextFileScanner scanner(streamOptions);
+            StreamSummary summary = scanner.scan(fileName, context.getCancellationToken());
+
+            // Sumarul este scris direct in buffer-ul refolosit al pasului
+            string& text = context.getTextBuffer(getIndex());
+            text.clear();
+            appendCount(text, "   Bytes: ", summary.byteCount);
+            appendCount(text, "   Lines: ", summary.lineCount);
+            if (!streamOptions.pattern.empty()) {
+                text += "   Lines matching '";
+                text += streamOptions.pattern;
+                appendCount(text, "': ", summary.matchCount);
+            }
+            if (streamOptions.headLines > 0) {
+                text += "   First lines:\n";
+                text += summary.head;
+            }
+            if (streamOptions.tailLines > 0) {
+                text += "   Last lines:\n";
+                text += summary.tail;
+            }
+            double value = streamOptions.pattern.empty() ? summary.lineCount : summary.matchCount;
+            context.publishNumberWithText(getIndex(), value);
+            output << text;
+            output << "------------------------------------" << endl;
+        } catch (const StepCancelled&) {
+            throw; // tratat de Flow ca timeout
+        } catch (const exception& e) {
+            errors << "Error: " << e.what() << endl;
+            context.incrementErrorCount(getIndex());
+        }
+    }
+
+    // Adauga "<label><count>\n" fara stringuri temporare
+    static void appendCount(string& text, const char* label, long long count) {
+        char digits[24];
+        text += label;
+        text.append(digits, to_chars(digits, digits + sizeof(digits), count).ptr);
+        text += '\n';
+    }
+
     // Metoda pentru citirea continutului fisierului
+    // Pasul poate fi construit de watcher, deci eroarea nu este scrisa prin cerr
     void readFileContent() {
         try {
-            ifstream fileStream(fileName);
-            if (fileStream.is_open()) {
-                string line;
-                while (getline(fileStream, line)) {
-                    fileContent += line + "\n";
-                }
-                fileStream.close();
-            } else {
-                throw runtime_error("Unable to open file - " + fileName);
-            }
+            fileContent.get();
         } catch (const exception& e) {
-            if(e.what() == "basic_ios::clear") {
-                cerr << "Error: Invalid input." << endl;
-            } else {
-                cerr << "Error: " << e.what() << endl;
-            }
+            printMessage(stderr, string("Error: ") + e.what());
             incrementErrorCount();
         }
     }
@@ -324,66 +1708,73 @@ class CsvFileInputStep : public Step {
 private:
     string description;
     string fileName;
-    string fileContent;
+    ReloadableContent fileContent;
 
 public:
-    CsvFileInputStep(const string& descriptionValue, const string& fileNameValue)
-        : Step("CSV_FILE_INPUT"), description(descriptionValue), fileName(fileNameValue) {
+    CsvFileInputStep(string descriptionValue, string fileNameValue)
+        : Step("CSV_FILE_INPUT"), description(move(descriptionValue)), fileName(move(fileNameValue)), fileContent(fileName, true) {
         readFileContent();
     }
 
-    void execute() override {
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        ostream& errors = context.getErrors();
         try {
-            cout << "Step Type: " << getStepType() << endl;
-            cout << "   Description: " << description << endl;
-            cout << "   File Name: " << fileName << endl;
-            cout << "   File Content: " << fileContent << endl;
-            cout << "------------------------------------" << endl;
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Description: " << description << endl;
+            output << "   File Name: " << fileName << endl;
+            context.getCancellationToken().throwIfCancelled();
+            shared_ptr<const CsvTable> table;
+            shared_ptr<const string> content = fileContent.get(table);
+            context.publishTable(getIndex(), table, content);
+            output << "   File Content: " << *content << endl;
+            output << "------------------------------------" << endl;
+        } catch (const StepCancelled&) {
+            throw; // tratat de Flow ca timeout
         } catch (const exception& e) {
             if(e.what() == "basic_ios::clear") {
-                cerr << "Error: Invalid input." << endl;
+                errors << "Error: Invalid input." << endl;
             } else {
-                cerr << "Error: " << e.what() << endl;
+                errors << "Error: " << e.what() << endl;
             }
-            incrementErrorCount();
+            context.incrementErrorCount(getIndex());
         }
     }
 
-    void print() const override {
-        cout << "Step Type: " << getStepType() << endl;
-        cout << "   Description: " << description << endl;
-        cout << "   File Name: " << fileName << endl;
-        cout << "   File Content: " << fileContent << endl;
-        cout << "------------------------------------" << endl;
+    void print(const RunContext& context, ostream& output) const override {
+        output << "Step Type: " << getStepType() << endl;
+        output << "   Description: " << description << endl;
+        output << "   File Name: " << fileName << endl;
+        try {
+            const StepResult& result = context.getResultAt(getIndex());
+            output << "   File Content: " << (result.text ? *result.text : *fileContent.get()) << endl;
+        } catch (const exception& e) {
+            output << "   File Content: " << e.what() << endl;
+        }
+        output << "------------------------------------" << endl;
     }
 
+    size_t getMemoryUsage() const override { return fileContent.getMemoryUsage(); }
+
     const string& getDescription() const { return description; }
     const string& getFileName() const { return fileName; }
-    const string& getFileContent() const { return fileContent; }
-    void setDescription(const string& descriptionValue) { description = descriptionValue; }
-    void setFileName(const string& fileNameValue) { fileName = fileNameValue; }
-    void setFileContent(const string& fileContentValue) { fileContent = fileContentValue; }
+    shared_ptr<const string> getFileContent() const { return fileContent.get(); }
+    shared_ptr<const CsvTable> getTable() const {
+        shared_ptr<const CsvTable> table;
+        fileContent.get(table);
+        return table;
+    }
+    void setDescription(string descriptionValue) { description = move(descriptionValue); }
+    void setFileName(string fileNameValue) { fileName = move(fileNameValue); fileContent.setFileName(fileName); }
+    void setFileContent(string fileContentValue) { fileContent.set(move(fileContentValue)); }
 
 private:
-    // Metoda pentru citirea continutului fisierului csv
+    // Metoda pentru citirea continutului fisierului csv (si pe thread-ul watcher-ului)
     void readFileContent() {
         try {
-            ifstream fileStream(fileName);
-            if (fileStream.is_open()) {
-                string line;
-                while (getline(fileStream, line)) {
-                    fileContent += line + "\n";
-                }
-                fileStream.close();
-            } else {
-                throw runtime_error("Unable to open file - " + fileName);
-            }
+            fileContent.get();
         } catch (const exception& e) {
-            if(e.what() == "basic_ios::clear") {
-                cerr << "Error: Invalid input." << endl;
-            } else {
-                cerr << "Error: " << e.what() << endl;
-            }
+            printMessage(stderr, string("Error: ") + e.what());
             incrementErrorCount();
         }
     }
@@ -391,27 +1782,30 @@ private:
 //clasa pentru DisplayStep
 class DisplayStep : public Step {
         public:
-            const Step& sourceStep;
+            int sourceStepId;
 
-            DisplayStep(const Step& sourceStepValue)
-                : Step("DISPLAY"), sourceStep(sourceStepValue) {}
+            DisplayStep(int sourceStepIdValue)
+                : Step("DISPLAY"), sourceStepId(sourceStepIdValue) {}
 
-            void execute() override {
+            // Afiseaza rezultatul publicat de pasul sursa, fara sa il ruleze din nou
+            void execute(RunContext& context) const override {
+                ostream& output = context.getOutput();
+                ostream& errors = context.getErrors();
                 try {
-                    cout << "Step Type: " << getStepType() << endl;
-                    cout << "   Displaying content of the previous step:" << endl;
-                    const_cast<Step&>(sourceStep).execute();
-                    cout << "------------------------------------" << endl;
+                    output << "Step Type: " << getStepType() << endl;
+                    output << "   Displaying content of the previous step:" << endl;
+                    findSourceStep(context, sourceStepId).print(context, output);
+                    output << "------------------------------------" << endl;
                 } catch (const exception& e) {
                    if(e.what() == "basic_ios::clear") {
-                        cerr << "Error: Invalid input." << endl;
+                        errors << "Error: Invalid input." << endl;
                     } else {
-                         cerr << "Error: " << e.what() << endl;
+                         errors << "Error: " << e.what() << endl;
                      }
-                    incrementErrorCount();
+                    context.incrementErrorCount(getIndex());
                 }
             }
-            void print () const override {
+            void print (const RunContext&, ostream&) const override {
                 return;
             }
 };
@@ -422,174 +1816,1136 @@ class OutputStep : public Step {
             string fileName;
             string title;
             string description;
-            const Step& sourceStep;
+            int sourceStepId;
 
-            OutputStep(int stepNumberValue, const string& fileNameValue, const string& titleValue,
-                       const string& descriptionValue, const Step& sourceStepValue)
-                : Step("OUTPUT"), stepNumber(stepNumberValue), fileName(fileNameValue),
-                  title(titleValue), description(descriptionValue), sourceStep(sourceStepValue) {}
+            OutputStep(int stepNumberValue, string fileNameValue, string titleValue,
+                       string descriptionValue, int sourceStepIdValue)
+                : Step("OUTPUT"), stepNumber(stepNumberValue), fileName(move(fileNameValue)),
+                  title(move(titleValue)), description(move(descriptionValue)), sourceStepId(sourceStepIdValue) {}
 
-            void execute() override {
+            void execute(RunContext& context) const override {
+                ostream& output = context.getOutput();
+                ostream& errors = context.getErrors();
                 try {
-                    cout << "Step Type: " << getStepType()<< endl;
-                    cout << "   Step Number: " << stepNumber << endl;
-                    cout << "   File Name: " << fileName << endl;
-                    cout << "   Title: " << title << endl;
-                    cout << "   Description: " << description << endl;
-
-                    string sourceStepInfo;
-                    sourceStepInfo += "Source Step Information:\n";
-
-                    ostringstream oss;
-                    streambuf* coutBuffer = cout.rdbuf();
-                    cout.rdbuf(oss.rdbuf());
-
-                    sourceStep.print();
-
-                    cout.rdbuf(coutBuffer);
-
-                    sourceStepInfo += oss.str();
-                    sourceStepInfo += "------------------------------------\n";
-
-                    ofstream outputFile(fileName, ios::app); 
-                    if (outputFile.is_open()) {
-                        outputFile << "Output Step Information:\n";
-                        outputFile << "   Step Number: " << stepNumber << "\n";
-                        outputFile << "   File Name: " << fileName << "\n";
-                        outputFile << "   Title: " << title << "\n";
-                        outputFile << "   Description: " << description << "\n\n";
-                        outputFile << sourceStepInfo;
-                        outputFile.close();
-                        cout << "   Output file generated successfully." << endl;
-                    } else {
-                        throw runtime_error("Unable to open output file - " + fileName);
-                    }
-
-                    cout << "------------------------------------" << endl;
+                    output << "Step Type: " << getStepType()<< endl;
+                    output << "   Step Number: " << stepNumber << endl;
+                    output << "   File Name: " << fileName << endl;
+                    output << "   Title: " << title << endl;
+                    output << "   Description: " << description << endl;
+
+                    const Step& sourceStep = findSourceStep(context, sourceStepId);
+
+                    context.getCancellationToken().throwIfCancelled();
+                    writeOutputFile(context, sourceStep, stepNumber, fileName, title, description);
+                    output << "   Output file generated successfully." << endl;
+                    output << "------------------------------------" << endl;
+                } catch (const StepCancelled&) {
+                    throw; // tratat de Flow ca timeout
                 } catch (const exception& e) {
                    if(e.what() == "basic_ios::clear") {
-                        cerr << "Error: Invalid input." << endl;
+                        errors << "Error: Invalid input." << endl;
                     } else {
-                        cerr << "Error: " << e.what() << endl;
+                        errors << "Error: " << e.what() << endl;
                     }
-                    incrementErrorCount();
+                    context.incrementErrorCount(getIndex());
                     }
             }
-            void print () const override {
+            void print (const RunContext&, ostream&) const override {
+                return;
+            }
+
+            // Metoda pentru scrierea fisierului, folosita si de StaticOutputStep
+            static void writeOutputFile(const RunContext& context, const Step& sourceStep, int stepNumber,
+                                        const string& fileName, const string& title, const string& description) {
+                // Buffer-ul fisierului este pe stiva, deci deschiderea fisierului nu aloca memorie
+                char fileBuffer[4096];
+                ofstream outputFile;
+                outputFile.rdbuf()->pubsetbuf(fileBuffer, sizeof(fileBuffer));
+                outputFile.open(fileName, ios::app);
+                if (!outputFile.is_open()) {
+                    throw runtime_error("Unable to open output file - " + fileName);
+                }
+                outputFile << "Output Step Information:\n";
+                outputFile << "   Step Number: " << stepNumber << "\n";
+                outputFile << "   File Name: " << fileName << "\n";
+                outputFile << "   Title: " << title << "\n";
+                outputFile << "   Description: " << description << "\n\n";
+                outputFile << "Source Step Information:\n";
+
+                // Pasul sursa se afiseaza direct in fisier, fara copie intermediara
+                // si fara sa redirectioneze cout-ul folosit de celelalte thread-uri
+                sourceStep.print(context, outputFile);
+
+                outputFile << "------------------------------------\n";
+                outputFile.close();
+            }
+
+        };
+
+//clasa pentru DisplayStep intr-un StaticFlow
+//pasul sursa este un index cunoscut la compilare, verificat de StaticFlow
+template <size_t Source>
+class StaticDisplayStep : public Step {
+public:
+    static constexpr size_t source = Source;
+
+    StaticDisplayStep() : Step("DISPLAY") {}
+
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        try {
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Displaying content of the previous step:" << endl;
+            context.getStepAt(Source).print(context, output);
+            output << "------------------------------------" << endl;
+        } catch (const exception& e) {
+            context.getErrors() << "Error: " << e.what() << endl;
+            context.incrementErrorCount(getIndex());
+        }
+    }
+    void print(const RunContext&, ostream&) const override {}
+};
+
+//clasa pentru OutputStep intr-un StaticFlow
+//pasul sursa este un index cunoscut la compilare, verificat de StaticFlow
+template <size_t Source>
+class StaticOutputStep : public Step {
+private:
+    string fileName;
+    string title;
+    string description;
+
+public:
+    static constexpr size_t source = Source;
+
+    StaticOutputStep(string fileNameValue, string titleValue, string descriptionValue)
+        : Step("OUTPUT"), fileName(move(fileNameValue)), title(move(titleValue)), description(move(descriptionValue)) {}
+
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        int stepNumber = static_cast<int>(getIndex()) + 1;
+        try {
+            output << "Step Type: " << getStepType() << endl;
+            output << "   Step Number: " << stepNumber << endl;
+            output << "   File Name: " << fileName << endl;
+            output << "   Title: " << title << endl;
+            output << "   Description: " << description << endl;
+            context.getCancellationToken().throwIfCancelled();
+            OutputStep::writeOutputFile(context, context.getStepAt(Source), stepNumber, fileName, title, description);
+            output << "   Output file generated successfully." << endl;
+            output << "------------------------------------" << endl;
+        } catch (const StepCancelled&) {
+            throw; // tratat de Flow ca timeout
+        } catch (const exception& e) {
+            context.getErrors() << "Error: " << e.what() << endl;
+            context.incrementErrorCount(getIndex());
+        }
+    }
+    void print(const RunContext&, ostream&) const override {}
+
+    const string& getFileName() const { return fileName; }
+    const string& getTitle() const { return title; }
+    const string& getDescription() const { return description; }
+};
+
+template <typename StepType>
+struct IsStaticSourceStep : false_type {};
+
+template <size_t Source>
+struct IsStaticSourceStep<StaticDisplayStep<Source>> : true_type {};
+
+template <size_t Source>
+struct IsStaticSourceStep<StaticOutputStep<Source>> : true_type {};
+
+//clasa pentru EndStep
+class EndStep : public Step {
+public:
+    EndStep() : Step("END") {}
+
+    void execute(RunContext& context) const override {
+        ostream& output = context.getOutput();
+        output << "Step Type: " << getStepType()<< endl;
+        output << "   End of the flow." << endl;
+        output << "------------------------------------" << endl;
+    }
+    bool handleUserInput() { return false; }
+};
+
+//clasa pentru analytics-ul scris de procesele worker direct in memoria partajata
+//contorii sunt atomici, deci workerii scriu fara lock-uri si parintele citeste totalurile fara mesaje
+class SharedAnalytics {
+public:
+    static const int maxFlows = 64;
+    static const int maxSteps = 64;
+    static const size_t maxNameLength = 64;
+
+private:
+    struct StepStats {
+        atomic<int> errorCount;
+        atomic<int> skippedCount;
+        atomic<int> completedCount;
+        atomic<int> timedOutCount;
+    };
+
+    struct FlowStats {
+        char name[maxNameLength];
+        atomic<int> startedCount;
+        atomic<int> completedCount;
+        atomic<int> skippedCount;
+        atomic<int> errorCount;
+        atomic<int> timedOutCount;
+        atomic<long long> allocationCount;
+        atomic<long long> allocatedBytes;
+        atomic<unsigned long long> stepSignature; // pasii cu care au rulat workerii
+        StepStats steps[maxSteps];
+    };
+
+    struct Data {
+        atomic<int> flowCount; // flow-urile sunt inregistrate doar de parinte
+        FlowStats flows[maxFlows];
+    };
+
+    Data* data;
+
+    SharedAnalytics() : data(nullptr) {}
+
+public:
+    static SharedAnalytics& instance() {
+        static SharedAnalytics analytics;
+        return analytics;
+    }
+
+    SharedAnalytics(const SharedAnalytics&) = delete;
+    SharedAnalytics& operator=(const SharedAnalytics&) = delete;
+
+    bool isMapped() const { return data != nullptr; }
+
+    // Zona este creata inainte de fork, deci este vazuta de toate procesele worker
+    bool map() {
+#ifndef _WIN32
+        if (data != nullptr) {
+            return true;
+        }
+        void* memory = mmap(nullptr, sizeof(Data), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return false;
+        }
+        data = new (memory) Data(); // memoria de la mmap este deja zero
+        return true;
+#else
+        return false;
+#endif
+    }
+
+    // Numarul si tipurile pasilor; se schimba cand flow-ul este reincarcat cu alti pasi
+    static unsigned long long stepSignature(const vector<Step*>& steps) {
+        unsigned long long hash = 14695981039346656037ULL;
+        for (const auto& step : steps) {
+            for (char c : step->getStepType()) {
+                hash = (hash ^ static_cast<unsigned char>(c)) * 1099511628211ULL;
+            }
+            hash = (hash ^ '/') * 1099511628211ULL;
+        }
+        return hash ^ steps.size();
+    }
+
+    // Apelata doar de parinte, cand nu ruleaza niciun worker; numele este scris inainte ca flow-ul sa devina vizibil
+    // Daca pasii s-au schimbat de la inregistrarea anterioara, contorii per pas vechi sunt stersi
+    void registerFlow(const string& flowName, const vector<Step*>& steps) {
+        if (data == nullptr) {
+            return;
+        }
+        unsigned long long signature = stepSignature(steps);
+        FlowStats* stats = find(flowName);
+        if (stats != nullptr) {
+            if (stats->stepSignature.load() != signature) {
+                for (auto& step : stats->steps) {
+                    step.errorCount = 0;
+                    step.skippedCount = 0;
+                    step.completedCount = 0;
+                    step.timedOutCount = 0;
+                }
+                stats->stepSignature.store(signature);
+            }
+            return;
+        }
+        int count = data->flowCount.load();
+        if (count >= maxFlows) {
+            return;
+        }
+        strncpy(data->flows[count].name, flowName.c_str(), maxNameLength - 1);
+        data->flows[count].stepSignature.store(signature);
+        data->flowCount.store(count + 1, memory_order_release);
+    }
+
+    // Apelata cand worker-ul a luat jobul, deci rularile in curs si cele pierdute sunt numarate ca pornite
+    void recordStart(const string& flowName) {
+        FlowStats* stats = find(flowName);
+        if (stats != nullptr) {
+            stats->startedCount.fetch_add(1, memory_order_relaxed);
+        }
+    }
+
+    void record(const string& flowName, const RunContext& context) {
+        FlowStats* stats = find(flowName);
+        if (stats == nullptr) {
+            return;
+        }
+        size_t stepCount = min(context.getStepCount(), static_cast<size_t>(maxSteps));
+        for (size_t i = 0; i < stepCount; ++i) {
+            stats->steps[i].errorCount.fetch_add(context.getErrorCount(i), memory_order_relaxed);
+            stats->steps[i].skippedCount.fetch_add(context.getSkippedCount(i), memory_order_relaxed);
+            stats->steps[i].completedCount.fetch_add(context.getCompletedCount(i), memory_order_relaxed);
+            stats->steps[i].timedOutCount.fetch_add(context.getTimedOutCount(i), memory_order_relaxed);
+            stats->errorCount.fetch_add(context.getErrorCount(i), memory_order_relaxed);
+            stats->skippedCount.fetch_add(context.getSkippedCount(i), memory_order_relaxed);
+            stats->timedOutCount.fetch_add(context.getTimedOutCount(i), memory_order_relaxed);
+        }
+        stats->allocationCount.fetch_add(context.getAllocations().count, memory_order_relaxed);
+        stats->allocatedBytes.fetch_add(context.getAllocations().bytes, memory_order_relaxed);
+        stats->completedCount.fetch_add(1, memory_order_relaxed);
+    }
+
+    void display(const string& flowName, const vector<Step*>& steps) const {
+        const FlowStats* stats = find(flowName);
+        if (stats == nullptr) {
+            return;
+        }
+        cout << "Worker pool totals for Flow: " << flowName << endl;
+        cout << "Started count: " << stats->startedCount << endl;
+        cout << "Completed count: " << stats->completedCount << endl;
+        cout << "Skipped count: " << stats->skippedCount << endl;
+        cout << "Error count: " << stats->errorCount << endl;
+        cout << "Timed out count: " << stats->timedOutCount << endl;
+        if (AllocationTracker::instance().isEnabled()) {
+            cout << "Heap allocations: " << stats->allocationCount << " (" << stats->allocatedBytes << " bytes)" << endl;
+        }
+        // Dupa un hot reload workerii pot rula inca pasii vechi; randurile lor nu corespund pasilor afisati
+        if (stats->stepSignature.load() != stepSignature(steps)) {
+            cout << "Per-step worker totals omitted: the flow was reloaded with different steps since the workers started." << endl;
+            return;
+        }
+        for (size_t i = 0; i < steps.size() && i < static_cast<size_t>(maxSteps); ++i) {
+            cout << "Step: " << steps[i]->getStepType() << endl;
+            cout << "Errors: " << stats->steps[i].errorCount << endl;
+            cout << "Skipped: " << stats->steps[i].skippedCount << endl;
+            cout << "Completed: " << stats->steps[i].completedCount << endl;
+            cout << "Timed out: " << stats->steps[i].timedOutCount << endl;
+        }
+    }
+
+private:
+    FlowStats* find(const string& flowName) const {
+        if (data == nullptr) {
+            return nullptr;
+        }
+        int count = data->flowCount.load(memory_order_acquire);
+        for (int i = 0; i < count; ++i) {
+            if (strncmp(data->flows[i].name, flowName.c_str(), maxNameLength - 1) == 0) {
+                return &data->flows[i];
+            }
+        }
+        return nullptr;
+    }
+};
+
+// Ce se intampla cu pasii ramasi dupa ce un pas a depasit deadline-ul
+enum TimeoutPolicy {
+    CONTINUE_ON_TIMEOUT,
+    ABORT_ON_TIMEOUT
+};
+
+class Flow {
+public:
+    string name;
+    vector<Step*> steps;
+
+    // Variabilele pentru analytics
+    int startedCount;
+    int completedCount;
+    int skippedCount;
+    int errorCount;
+    int timedOutCount;
+    long long allocationCount; // numarate doar in modul de instrumentare
+    long long allocatedBytes;
+
+    // Deadline-ul intregii rulari (0 inseamna fara deadline)
+    int deadlineMs;
+    TimeoutPolicy timeoutPolicy;
+
+    // Fisierul de definitie din care a fost incarcat flow-ul (gol pentru flow-urile create din meniu)
+    string sourceFile;
+
+    // ownsSteps este false cand pasii apartin altui obiect (de exemplu unui StaticFlow)
+    Flow(string flowName, bool ownsStepsValue = true)
+        : name(move(flowName)), startedCount(0), completedCount(0), skippedCount(0), errorCount(0), timedOutCount(0),
+          allocationCount(0), allocatedBytes(0), deadlineMs(0), timeoutPolicy(CONTINUE_ON_TIMEOUT), ownsSteps(ownsStepsValue), nextStepId(1) {}
+
+    ~Flow() {
+        if (!ownsSteps) {
+            return;
+        }
+        for (auto step : steps) {
+            delete step;
+        }
+    }
+
+    void addStep(Step* step) {
+        step->setId(nextStepId++);
+        step->setIndex(steps.size());
+        steps.push_back(step);
+    }
+
+    // Fiecare rulare are propriul context (starea si stream-urile ei), deci acelasi flow poate rula
+    // de mai multe ori simultan; rularile simultane primesc stream-uri separate, altfel impart cin/cout
+    RunContext createContext(istream& input = cin, ostream& output = cout, ostream& errors = cerr) const {
+        return RunContext(steps, input, output, errors);
+    }
+
+    void run() {
+        RunContext context = createContext();
+        run(context);
+    }
+
+    void run(RunContext& context) {
+        context.reset();
+        AllocationTracker::RunScope allocationScope(context.getAllocations());
+        recordStart();
+        printHeader(context.getOutput());
+
+        DeadlineGuard flowDeadline(context.getFlowToken(), deadlineMs);
+        bool aborted = false;
+        for (auto& step : steps) {
+            if (aborted || context.getFlowToken().isCancelled()) {
+                context.incrementSkippedCount(step->getIndex());
+                aborted = true;
+                continue;
+            }
+            int decision = askDecision(*step, context);
+            if (context.getFlowToken().isCancelled()) {
+                context.incrementSkippedCount(step->getIndex()); // deadline-ul a expirat in timpul intrebarii
+                aborted = true;
+                continue;
+            }
+            if (decision == 1) {
+                context.incrementSkippedCount(step->getIndex());
+                continue;
+            }
+            if (decision == 0) {
+                aborted = !executeStep(*step, context, [&]() { step->execute(context); });
+            }
+        }
+
+        recordRun(context); // Adunam rezultatele rularii in analytics
+        context.releaseResults();
+        context.getOutput() << (aborted ? "Flow aborted: deadline exceeded." : "Flow completed.") << endl;
+    }
+
+    // Rulare fara intrebari de skip, pentru pipeline-uri automate
+    void runAll(RunContext& context) {
+        context.reset();
+        recordStart();
+        executeAll(context);
+        recordRun(context);
+        context.releaseResults();
+    }
+
+    // Ruleaza toti pasii fara sa atinga analytics-ul flow-ului (folosita si de procesele worker)
+    void executeAll(RunContext& context) const {
+        AllocationTracker::RunScope allocationScope(context.getAllocations());
+        DeadlineGuard flowDeadline(context.getFlowToken(), deadlineMs);
+        bool aborted = false;
+        for (auto& step : steps) {
+            if (aborted) {
+                context.incrementSkippedCount(step->getIndex());
+                continue;
+            }
+            aborted = !executeStep(*step, context, [&]() { step->execute(context); });
+        }
+    }
+
+    // Ruleaza un pas sub deadline-ul lui; intoarce false daca restul flow-ului trebuie oprit
+    template <typename Execute>
+    bool executeStep(const Step& step, RunContext& context, Execute execute) const {
+        CancellationToken& token = context.getStepToken();
+        token.reset();
+        bool timedOut = false;
+        {
+            AllocationTracker::StepScope allocationScope(step.getAllocationCounter());
+            DeadlineGuard stepDeadline(token, step.getDeadlineMs());
+            try {
+                execute();
+            } catch (const StepCancelled& e) {
+                context.getErrors() << "Timeout: " << e.what() << endl;
+                timedOut = true;
+            }
+            timedOut = timedOut || token.isCancelled();
+        }
+        if (!timedOut) {
+            context.incrementCompletedCount(step.getIndex());
+            return true;
+        }
+        context.incrementTimedOutCount(step.getIndex());
+        return timeoutPolicy == CONTINUE_ON_TIMEOUT && !context.getFlowToken().isCancelled();
+    }
+
+    void printHeader(ostream& output) const {
+        tm timestamp;
+        time_t now = time(0);
+        timestamp = *localtime(&now);
+
+        output << "Flow Name: " << name << endl;
+        output << "Timestamp: "
+             << timestamp.tm_year + 1900 << '-'
+             << timestamp.tm_mon + 1 << '-'
+             << timestamp.tm_mday << ' '
+             << timestamp.tm_hour << ':'
+             << timestamp.tm_min << ':'
+             << timestamp.tm_sec << endl;
+        output << "------------------------------------" << endl;
+    }
+
+    // Verificam daca vrea sa sara peste pas sau sa il execute
+    // Intoarce -1 daca deadline-ul flow-ului a expirat in timpul asteptarii
+    static int askDecision(const Step& step, RunContext& context) {
+        ostream& output = context.getOutput();
+        output << "Step: " << step.getStepType() << endl;
+        output << "Do you want to skip to the next step? (yes(1)/no(0)): ";
+        try {
+            waitForInput(context.getInput(), context.getFlowToken());
+        } catch (const StepCancelled&) {
+            output << endl;
+            return -1;
+        }
+        int decision;
+        context.getInput() >> decision;
+        if (decision == 1) {
+            output << "Skipping the current step." << endl;
+        }
+        return decision;
+    }
+
+    void recordStart() {
+        lock_guard<mutex> lock(analyticsMutex);
+        startedCount++;
+    }
+
+    // Metoda pentru adunarea contorilor unei rulari in analytics-ul flow-ului
+    void recordRun(const RunContext& context) {
+        lock_guard<mutex> lock(analyticsMutex);
+        for (auto step : steps) {
+            size_t index = step->getIndex();
+            step->setErrorCount(step->getErrorCount() + context.getErrorCount(index));
+            step->setSkippedCount(step->getSkippedCount() + context.getSkippedCount(index));
+            step->setCompletedCount(step->getCompletedCount() + context.getCompletedCount(index));
+            step->setTimedOutCount(step->getTimedOutCount() + context.getTimedOutCount(index));
+            errorCount += context.getErrorCount(index);
+            skippedCount += context.getSkippedCount(index);
+            timedOutCount += context.getTimedOutCount(index);
+        }
+        allocationCount += context.getAllocations().count;
+        allocatedBytes += context.getAllocations().bytes;
+        completedCount++; // Incrementam numarul de flow-uri completate
+    }
+
+    // Memoria ocupata de continutul incarcat al pasilor
+    size_t getMemoryUsage() const {
+        size_t total = 0;
+        for (const auto& step : steps) {
+            total += step->getMemoryUsage();
+        }
+        return total;
+    }
+
+    //Metoda pentru afisarea datelor
+    void displayAnalytics() const {
+        lock_guard<mutex> lock(analyticsMutex);
+        cout << "Analytics for Flow: " << name << endl;
+        cout << "Started count: " << startedCount << endl;
+        cout << "Completed count: " << completedCount << endl;
+        cout << "Skipped count: " << skippedCount << endl;
+        cout << "Error count: " << errorCount << endl;
+        cout << "Timed out count: " << timedOutCount << endl;
+
+        if (completedCount > 0) {
+            double averageErrors = static_cast<double>(errorCount) / completedCount;
+            cout << "Average errors per completed flow: " << averageErrors << endl;
+        } else {
+            cout << "Average errors per completed flow: N/A (no completed flows)" << endl;
+        }
+        cout << "Memory usage: " << getMemoryUsage() << " bytes" << endl;
+        if (AllocationTracker::instance().isEnabled()) {
+            cout << "Heap allocations: " << allocationCount << " (" << allocatedBytes << " bytes)" << endl;
+        }
+        for (const auto& step : steps) {
+            cout << "Step: " << step->getStepType() << endl;
+            step->displayErrors();
+            step->displaySkippedCount();
+            step->displayCompletedCount();
+            step->displayTimedOutCount();
+        }
+        SharedAnalytics::instance().display(name, steps);
+    }
+
+private:
+    bool ownsSteps;
+    int nextStepId;
+    mutable mutex analyticsMutex;
+};
+
+//clasa pentru flow-uri cu secventa de pasi fixata la compilare
+//pasii stau intr-un tuple, fara alocari pe heap; referintele intre pasi sunt indecsi verificati la compilare
+//fiecare pas trece totusi prin Flow::executeStep (deadline, token, contorii de alocari), ca in Flow,
+//iar la benchmark rularea statica nu a fost mai rapida decat cea dinamica (~1.0x)
+//ex: StaticFlow flow("calc", NumberInputStep("a"), NumberInputStep("b"), StaticCalculusStep<0, 1, OPERATION_ADD>(),
+//                    StaticDisplayStep<2>());
+template <typename... Steps>
+class StaticFlow {
+private:
+    tuple<Steps...> steps;
+    Flow flow; // vedere dinamica asupra pasilor, pentru analytics si OutputStep
+
+public:
+    StaticFlow(string flowName, Steps... stepValues)
+        : steps(move(stepValues)...), flow(move(flowName), false) {
+        registerSteps(index_sequence_for<Steps...>{});
+    }
+
+    StaticFlow(const StaticFlow&) = delete;
+    StaticFlow& operator=(const StaticFlow&) = delete;
+
+    template <size_t Index>
+    const tuple_element_t<Index, tuple<Steps...>>& getStep() const { return get<Index>(steps); }
+
+    Flow& getFlow() { return flow; }
+    const Flow& getFlow() const { return flow; }
+
+    RunContext createContext(istream& input = cin, ostream& output = cout, ostream& errors = cerr) const {
+        return flow.createContext(input, output, errors);
+    }
+
+    void run() {
+        RunContext context = createContext();
+        run(context);
+    }
+
+    void run(RunContext& context) {
+        context.reset();
+        AllocationTracker::RunScope allocationScope(context.getAllocations());
+        flow.recordStart();
+        flow.printHeader(context.getOutput());
+        DeadlineGuard flowDeadline(context.getFlowToken(), flow.deadlineMs);
+        bool aborted = false;
+        runSteps(context, aborted, index_sequence_for<Steps...>{});
+        flow.recordRun(context);
+        context.releaseResults();
+        context.getOutput() << (aborted ? "Flow aborted: deadline exceeded." : "Flow completed.") << endl;
+    }
+
+    void runAll(RunContext& context) {
+        context.reset();
+        AllocationTracker::RunScope allocationScope(context.getAllocations());
+        flow.recordStart();
+        DeadlineGuard flowDeadline(context.getFlowToken(), flow.deadlineMs);
+        bool aborted = false;
+        executeSteps(context, aborted, index_sequence_for<Steps...>{});
+        flow.recordRun(context);
+        context.releaseResults();
+    }
+
+    void displayAnalytics() const { flow.displayAnalytics(); }
+
+private:
+    template <size_t... Indexes>
+    void registerSteps(index_sequence<Indexes...>) {
+        (checkReferences<Indexes>(), ...);
+        (flow.addStep(&get<Indexes>(steps)), ...);
+    }
+
+    template <size_t... Indexes>
+    void runSteps(RunContext& context, bool& aborted, index_sequence<Indexes...>) const {
+        (runStep<Indexes>(context, aborted, true), ...);
+    }
+
+    template <size_t... Indexes>
+    void executeSteps(RunContext& context, bool& aborted, index_sequence<Indexes...>) const {
+        (runStep<Indexes>(context, aborted, false), ...);
+    }
+
+    template <size_t Index>
+    void runStep(RunContext& context, bool& aborted, bool interactive) const {
+        using StepType = tuple_element_t<Index, tuple<Steps...>>;
+        const StepType& step = get<Index>(steps);
+        if (aborted) {
+            context.incrementSkippedCount(Index);
+            return;
+        }
+        // Ca in Flow::run si Flow::executeAll: deadline-ul flow-ului se verifica separat doar la intrebari
+        if (interactive) {
+            int decision = context.getFlowToken().isCancelled() ? -1 : Flow::askDecision(step, context);
+            if (context.getFlowToken().isCancelled()) {
+                context.incrementSkippedCount(Index); // deadline-ul a expirat inainte sau in timpul intrebarii
+                aborted = true;
+                return;
+            }
+            if (decision != 0) {
+                if (decision == 1) {
+                    context.incrementSkippedCount(Index);
+                }
                 return;
             }
+        }
+        // apel calificat al pasului; costul comun din executeStep ramane
+        aborted = !flow.executeStep(step, context, [&]() { step.StepType::execute(context); });
+    }
 
-        };
+    // Referintele intre pasi sunt verificate la compilare
+    template <size_t Index>
+    static constexpr void checkReferences() {
+        using StepType = tuple_element_t<Index, tuple<Steps...>>;
+        if constexpr (IsStaticCalculusStep<StepType>::value) {
+            static_assert(StepType::operand1 < Index && StepType::operand2 < Index,
+                          "Calculus operands must be steps placed before the calculus step.");
+            if constexpr (StepType::operand1 < Index && StepType::operand2 < Index) {
+                static_assert(is_same<tuple_element_t<StepType::operand1, tuple<Steps...>>, NumberInputStep>::value &&
+                              is_same<tuple_element_t<StepType::operand2, tuple<Steps...>>, NumberInputStep>::value,
+                              "Calculus operands must be Number Input Steps.");
+            }
+        }
+        if constexpr (IsStaticSourceStep<StepType>::value) {
+            static_assert(StepType::source < Index, "The source step must be placed before the step that shows it.");
+        }
+        // ID-urile pasilor nu sunt cunoscute la compilare, deci pasii care refera alt pas dupa ID nu sunt acceptati
+        static_assert(!is_same<StepType, DisplayStep>::value && !is_same<StepType, OutputStep>::value &&
+                      !is_same<StepType, CalculusStep>::value,
+                      "Use StaticDisplayStep, StaticOutputStep and StaticCalculusStep in a StaticFlow.");
+    }
+};
+
+//streambuf care ignora tot ce se scrie, folosit la benchmark si de procesele worker
+//zona de scriere este refolosita, deci textul nu trece caracter cu caracter prin overflow()
+class NullBuffer : public streambuf {
+private:
+    char buffer[1024];
 
-//clasa pentru EndStep
-class EndStep : public Step {
 public:
-    EndStep() : Step("END") {}
+    NullBuffer() { setp(buffer, buffer + sizeof(buffer)); }
 
-    void execute() override {
-        cout << "Step Type: " << getStepType()<< endl;
-        cout << "   End of the flow." << endl;
-        cout << "------------------------------------" << endl;
+protected:
+    int overflow(int c) override {
+        setp(buffer, buffer + sizeof(buffer));
+        return traits_type::not_eof(c);
     }
-    bool handleUserInput() { return false; }
+
+    streamsize xsputn(const char*, streamsize count) override { return count; }
 };
 
-class Flow {
+//streambuf pentru citirea unui text existent, fara sa il copieze (inputul joburilor din WorkerPool)
+class TextBuffer : public streambuf {
 public:
-    string name;
-    vector<Step*> steps;
+    void setText(const char* text) {
+        char* begin = const_cast<char*>(text); // zona este doar citita
+        setg(begin, begin, begin + strlen(text));
+    }
+};
 
-    // Variabilele pentru analytics
-    int startedCount;
-    int completedCount;
-    int skippedCount;
-    int errorCount;
+#ifndef _WIN32
+//clasa pentru un pool de procese worker care iau rulari de flow-uri dintr-o coada in memoria partajata
+//fiecare worker este izolat: daca un proces cade, se pierde doar rularea lui curenta
+class WorkerPool {
+public:
+    static const size_t queueSize = 256;
+    static const int maxWorkers = 64;
+    static const size_t maxInputLength = 256;
 
-    Flow(const string& flowName)
-        : name(flowName), startedCount(0), completedCount(0), skippedCount(0), errorCount(0) {}
+    struct Job {
+        char flowName[SharedAnalytics::maxNameLength]; // gol inseamna oprirea worker-ului
+        char input[maxInputLength];                    // raspunsurile pentru pasii de input
+    };
 
-    ~Flow() {
-        for (auto step : steps) {
-            delete step;
+private:
+    // Coada circulara: fiecare celula are un numar de secventa care arata
+    // daca asteapta un producator (pos) sau un consumator (pos + 1)
+    struct Cell {
+        atomic<size_t> sequence;
+        Job job;
+    };
+
+    struct Queue {
+        Cell cells[queueSize];
+        atomic<size_t> enqueuePosition;
+        atomic<size_t> dequeuePosition;
+        sem_t availableJobs;
+        sem_t freeCells;
+        atomic<int> busy[maxWorkers]; // 1 cat timp worker-ul ruleaza un job
+        atomic<int> finishedJobs;
+        atomic<int> lostJobs;
+    };
+
+    Queue* queue;
+    vector<pid_t> workers;
+    vector<shared_ptr<Flow>> flows; // copia catalogului la pornirea pool-ului
+    mutex* forkMutex; // tinut de celelalte thread-uri cat timp pot tine lock-uri de care are nevoie un worker
+
+public:
+    WorkerPool(mutex* forkMutexValue = nullptr) : queue(nullptr), forkMutex(forkMutexValue) {}
+
+    ~WorkerPool() {
+        stop();
+    }
+
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    bool isRunning() const { return !workers.empty(); }
+
+    // Trebuie apelata din thread-ul principal
+    bool start(int workerCount, const vector<shared_ptr<Flow>>& flowsValue) {
+        if (isRunning() || workerCount < 1 || workerCount > maxWorkers || !SharedAnalytics::instance().map()) {
+            return false;
+        }
+        void* memory = mmap(nullptr, sizeof(Queue), PROT_READ | PROT_WRITE, MAP_SHARED | MAP_ANONYMOUS, -1, 0);
+        if (memory == MAP_FAILED) {
+            return false;
         }
+        queue = new (memory) Queue();
+        for (size_t i = 0; i < queueSize; ++i) {
+            queue->cells[i].sequence.store(i);
+        }
+        sem_init(&queue->availableJobs, 1, 0);
+        sem_init(&queue->freeCells, 1, queueSize);
+
+        flows = flowsValue;
+        for (const auto& flow : flows) {
+            SharedAnalytics::instance().registerFlow(flow->name, flow->steps);
+        }
+        workers.assign(workerCount, 0);
+        for (int i = 0; i < workerCount; ++i) {
+            spawn(i);
+        }
+        return true;
     }
 
-    void addStep(Step* step) {
-        steps.push_back(step);
+    // Pune un job in coada; asteapta daca coada este plina
+    // Intoarce false, fara sa puna jobul in coada, daca flow-ul nu este in copia catalogului pool-ului
+    bool submit(const string& flowName, const string& input) {
+        if (flowName.empty() || flowName.size() >= sizeof(Job::flowName) ||
+            none_of(flows.begin(), flows.end(), [&flowName](const shared_ptr<Flow>& flow) { return flow->name == flowName; })) {
+            return false;
+        }
+        Job job;
+        memset(&job, 0, sizeof(job));
+        strncpy(job.flowName, flowName.c_str(), sizeof(job.flowName) - 1);
+        strncpy(job.input, input.c_str(), sizeof(job.input) - 1);
+        enqueue(job);
+        return true;
     }
 
-    void run() {
-        startedCount++;
+    // Reporneste workerii care au cazut; jobul lor curent este numarat ca pierdut
+    void supervise() {
+        for (size_t i = 0; i < workers.size(); ++i) {
+            int status;
+            if (workers[i] > 0 && waitpid(workers[i], &status, WNOHANG) == workers[i]) {
+                if (queue->busy[i].exchange(0) != 0) {
+                    queue->lostJobs++;
+                }
+                spawn(i);
+            }
+        }
+    }
 
-        tm timestamp;
-        time_t now = time(0);
-        timestamp = *localtime(&now);
+    void stop() {
+        if (!isRunning()) {
+            return;
+        }
+        supervise();
+        Job stopJob;
+        memset(&stopJob, 0, sizeof(stopJob));
+        for (size_t i = 0; i < workers.size(); ++i) {
+            enqueue(stopJob);
+        }
+        for (pid_t worker : workers) {
+            waitpid(worker, nullptr, 0);
+        }
+        workers.clear();
+        flows.clear();
+        sem_destroy(&queue->availableJobs);
+        sem_destroy(&queue->freeCells);
+        munmap(queue, sizeof(Queue));
+        queue = nullptr;
+    }
 
-        cout << "Flow Name: " << name << endl;
-        cout << "Timestamp: "
-             << timestamp.tm_year + 1900 << '-'
-             << timestamp.tm_mon + 1 << '-'
-             << timestamp.tm_mday << ' '
-             << timestamp.tm_hour << ':'
-             << timestamp.tm_min << ':'
-             << timestamp.tm_sec << endl;
-        cout << "------------------------------------" << endl;
+    void displayStatus() const {
+        if (!isRunning()) {
+            cout << "Worker pool is not running." << endl;
+            return;
+        }
+        int pending = 0;
+        sem_getvalue(&queue->availableJobs, &pending);
+        cout << "Workers: " << workers.size() << endl;
+        cout << "Pending jobs: " << pending << endl;
+        cout << "Finished jobs: " << queue->finishedJobs << endl;
+        cout << "Lost jobs (crashed workers): " << queue->lostJobs << endl;
+    }
 
-        for (auto& step : steps) {
-            // Verificam daca vrea sa sara peste pas sau sa il execute
-            cout << "Step: " << step->getStepType() << endl;
-            cout << "Do you want to skip to the next step? (yes(1)/no(0)): ";
-            int decision;
-            cin >> decision;
-            if (decision == 1) {
-                cout << "Skipping the current step." << endl;
-                step->incrementSkippedCount();
-                skippedCount++;
+private:
+    // Copilul mosteneste doar thread-ul care face fork(); un lock tinut atunci de alt thread
+    // (ex: contentMutex-ul unui pas, in timpul unei evictii facute de watcher) ar ramane blocat pentru totdeauna
+    void spawn(int slot) {
+        unique_lock<mutex> lock;
+        if (forkMutex != nullptr) {
+            lock = unique_lock<mutex>(*forkMutex);
+        }
+        cout.flush();
+        cerr.flush();
+        pid_t pid = fork();
+        if (pid == 0) {
+            workerMain(slot);
+            _exit(0); // fara destructorii statici ai parintelui
+        }
+        workers[slot] = pid;
+    }
+
+    // Cat timp coada este plina verificam periodic workerii: daca toti au cazut,
+    // doar cei reporniti de supervise() mai pot elibera celule
+    void enqueue(const Job& job) {
+        while (true) {
+            timespec timeout;
+            clock_gettime(CLOCK_REALTIME, &timeout);
+            timeout.tv_nsec += 100 * 1000 * 1000;
+            if (timeout.tv_nsec >= 1000 * 1000 * 1000) {
+                timeout.tv_sec++;
+                timeout.tv_nsec -= 1000 * 1000 * 1000;
+            }
+            if (sem_timedwait(&queue->freeCells, &timeout) == 0) {
+                break;
+            }
+            if (errno == ETIMEDOUT) {
+                supervise();
+            }
+        }
+        size_t position = queue->enqueuePosition.fetch_add(1);
+        Cell& cell = queue->cells[position % queueSize];
+        while (cell.sequence.load(memory_order_acquire) != position) {
+            this_thread::yield();
+        }
+        cell.job = job;
+        cell.sequence.store(position + 1, memory_order_release);
+        sem_post(&queue->availableJobs);
+    }
+
+    // busy este setat imediat ce worker-ul a rezervat un job, deci o cadere dupa acest punct pierde jobul
+    void dequeue(int slot, Job& job) {
+        while (sem_wait(&queue->availableJobs) != 0) {
+        }
+        queue->busy[slot] = 1;
+        size_t position = queue->dequeuePosition.fetch_add(1);
+        Cell& cell = queue->cells[position % queueSize];
+        while (cell.sequence.load(memory_order_acquire) != position + 1) {
+            this_thread::yield();
+        }
+        job = cell.job;
+        cell.sequence.store(position + queueSize, memory_order_release);
+        sem_post(&queue->freeCells);
+    }
+
+    void workerMain(int slot) {
+        Watchdog::instance().resetAfterFork();
+        MemoryBudget::instance().resetAfterFork();
+        NullBuffer nullBuffer;
+        cout.rdbuf(&nullBuffer);
+        cerr.rdbuf(&nullBuffer);
+
+        // Un context refolosit pentru fiecare flow, deci rularile repetate nu mai aloca memorie
+        // Inputul jobului este citit prin stream-ul contextului, nu prin cin
+        TextBuffer input;
+        istream jobInput(&input);
+        ostream discardedOutput(&nullBuffer);
+        vector<unique_ptr<RunContext>> contexts;
+        for (const auto& flow : flows) {
+            contexts.push_back(make_unique<RunContext>(flow->steps, jobInput, discardedOutput, discardedOutput));
+        }
+
+        while (true) {
+            Job job;
+            dequeue(slot, job);
+            if (job.flowName[0] == '\0') {
+                queue->busy[slot] = 0;
+                return;
+            }
+            for (size_t i = 0; i < flows.size(); ++i) {
+                const Flow& flow = *flows[i];
+                if (flow.name == job.flowName) {
+                    RunContext& context = *contexts[i];
+                    SharedAnalytics::instance().recordStart(flow.name);
+                    input.setText(job.input);
+                    jobInput.clear(); // starea (eof, fail) ramasa de la jobul anterior
+                    context.reset();
+                    flow.executeAll(context);
+                    SharedAnalytics::instance().record(flow.name, context);
+                    context.releaseResults();
+                    break;
+                }
+            }
+            queue->busy[slot] = 0;
+            queue->finishedJobs++;
+        }
+    }
+};
+#endif
+
+//clasa pentru citirea unui flow dintr-un fisier de definitie (<nume>.flow)
+//fiecare linie este un pas cu campurile separate prin '|'; liniile goale si cele cu '#' sunt ignorate
+//pasii sunt referiti prin numarul lor de ordine din fisier (primul pas este 1):
+//   DEADLINE|ms|continue sau abort
+//   TITLE|title|subtitle
+//   TEXT|title|copy
+//   TEXT_INPUT|description
+//   NUMBER_INPUT|description
+//   CALCULUS|operand1|operand2|operation
+//   TEXT_FILE_INPUT|description|file
+//   TEXT_FILE_STREAM|description|file|pattern|head lines|tail lines
+//   CSV_FILE_INPUT|description|file
+//   DISPLAY|source
+//   OUTPUT|source|file|title|description
+//   STEP_DEADLINE|step|ms
+class FlowFileParser {
+public:
+    static const char* extension() { return ".flow"; }
+
+    // Arunca exceptie cu numarul liniei daca fisierul nu este valid
+    static shared_ptr<Flow> parse(const string& path, const string& flowName) {
+        ifstream fileStream(path);
+        if (!fileStream.is_open()) {
+            throw runtime_error("Unable to open file - " + path);
+        }
+        shared_ptr<Flow> flow = make_shared<Flow>(flowName);
+        string line;
+        int lineNumber = 0;
+        while (getline(fileStream, line)) {
+            lineNumber++;
+            if (!line.empty() && line.back() == '\r') {
+                line.pop_back();
+            }
+            if (line.empty() || line[0] == '#') {
                 continue;
             }
-            if (decision == 0) {
-                step->execute();
-                step->incrementCompletedCount();
+            try {
+                parseLine(*flow, split(line));
+            } catch (const exception& e) {
+                throw runtime_error(path + ":" + to_string(lineNumber) + ": " + e.what());
             }
         }
+        return flow;
+    }
 
-        completedCount++; // Incrementam numarul de flow-uri completate
-        cout << "Flow completed." << endl;
+private:
+    static vector<string> split(const string& line) {
+        vector<string> fields;
+        size_t start = 0;
+        while (true) {
+            size_t separator = line.find('|', start);
+            fields.push_back(line.substr(start, separator == string::npos ? string::npos : separator - start));
+            if (separator == string::npos) {
+                return fields;
+            }
+            start = separator + 1;
+        }
     }
 
-    //Metoda pentru afisarea datelor
-    void displayAnalytics() const {
-        cout << "Analytics for Flow: " << name << endl;
-        cout << "Started count: " << startedCount << endl;
-        cout << "Completed count: " << completedCount << endl;
-        cout << "Skipped count: " << skippedCount << endl;
-        cout << "Error count: " << errorCount << endl;
+    static void expectFields(const vector<string>& fields, size_t count) {
+        if (fields.size() != count) {
+            throw runtime_error(fields[0] + " expects " + to_string(count - 1) + " fields.");
+        }
+    }
 
-        if (completedCount > 0) {
-            double averageErrors = static_cast<double>(errorCount) / completedCount;
-            cout << "Average errors per completed flow: " << averageErrors << endl;
-        } else {
-            cout << "Average errors per completed flow: N/A (no completed flows)" << endl;
+    static int toInt(const string& value) {
+        size_t parsed = 0;
+        int result = stoi(value, &parsed);
+        if (parsed != value.size()) {
+            throw invalid_argument("Invalid number '" + value + "'.");
         }
-        for (const auto& step : steps) {
-            cout << "Step: " << step->getStepType() << endl;
-            step->displayErrors();
-            step->displaySkippedCount();
-            step->displayCompletedCount();
+        return result;
+    }
+
+    // Pasul referit trebuie sa fie definit inaintea pasului curent
+    static const Step& referencedStep(const Flow& flow, const string& value) {
+        int position = toInt(value);
+        if (position < 1 || static_cast<size_t>(position) > flow.steps.size()) {
+            throw runtime_error("Step " + value + " is not defined before this step.");
+        }
+        return *flow.steps[position - 1];
+    }
+
+    // Campurile sunt mutate in pasi, fara copii
+    static void parseLine(Flow& flow, vector<string> fields) {
+        const string& type = fields[0];
+        if (type == "DEADLINE") {
+            expectFields(fields, 3);
+            flow.deadlineMs = toInt(fields[1]);
+            flow.timeoutPolicy = fields[2] == "abort" ? ABORT_ON_TIMEOUT : CONTINUE_ON_TIMEOUT;
+        } else if (type == "STEP_DEADLINE") {
+            expectFields(fields, 3);
+            const_cast<Step&>(referencedStep(flow, fields[1])).setDeadlineMs(toInt(fields[2]));
+        } else if (type == "TITLE") {
+            expectFields(fields, 3);
+            flow.addStep(new TitleStep(move(fields[1]), move(fields[2])));
+        } else if (type == "TEXT") {
+            expectFields(fields, 3);
+            flow.addStep(new TextStep(move(fields[1]), move(fields[2])));
+        } else if (type == "TEXT_INPUT") {
+            expectFields(fields, 2);
+            flow.addStep(new TextInputStep(move(fields[1])));
+        } else if (type == "NUMBER_INPUT") {
+            expectFields(fields, 2);
+            flow.addStep(new NumberInputStep(move(fields[1])));
+        } else if (type == "CALCULUS") {
+            expectFields(fields, 4);
+            const Step& operand1 = referencedStep(flow, fields[1]);
+            const Step& operand2 = referencedStep(flow, fields[2]);
+            if (dynamic_cast<const NumberInputStep*>(&operand1) == nullptr ||
+                dynamic_cast<const NumberInputStep*>(&operand2) == nullptr) {
+                throw runtime_error("Calculus operands must be Number Input Steps.");
+            }
+            flow.addStep(new CalculusStep(operand1.getId(), operand2.getId(), move(fields[3])));
+        } else if (type == "TEXT_FILE_INPUT") {
+            expectFields(fields, 3);
+            flow.addStep(new TextFileInputStep(move(fields[1]), move(fields[2])));
+        } else if (type == "TEXT_FILE_STREAM") {
+            expectFields(fields, 6);
+            StreamOptions options;
+            options.pattern = move(fields[3]);
+            options.headLines = toInt(fields[4]);
+            options.tailLines = toInt(fields[5]);
+            flow.addStep(new TextFileInputStep(move(fields[1]), move(fields[2]), move(options)));
+        } else if (type == "CSV_FILE_INPUT") {
+            expectFields(fields, 3);
+            flow.addStep(new CsvFileInputStep(move(fields[1]), move(fields[2])));
+        } else if (type == "DISPLAY") {
+            expectFields(fields, 2);
+            flow.addStep(new DisplayStep(referencedStep(flow, fields[1]).getId()));
+        } else if (type == "OUTPUT") {
+            expectFields(fields, 5);
+            int sourceId = referencedStep(flow, fields[1]).getId();
+            flow.addStep(new OutputStep(flow.steps.size() + 1, move(fields[2]), move(fields[3]), move(fields[4]), sourceId));
+        } else {
+            throw runtime_error("Unknown step type '" + type + "'.");
         }
     }
 };
 
 class FlowManager {
 public:
-    vector<Flow*> flows;
+    // Flow-urile sunt partajate: o rulare in curs pastreaza versiunea veche chiar daca fisierul este reincarcat
+    vector<shared_ptr<Flow>> flows;
 
-    FlowManager() {}
+    FlowManager() : watching(false) {}
 
     ~FlowManager() {
-        for (auto flow : flows) {
-            delete flow;
-        }
+        stopWatching();
+#ifndef _WIN32
+        workerPool.stop();
+#endif
     }
 
 
@@ -597,10 +2953,13 @@ public:
         string flowName;
         cout << "Enter the name of the new flow: ";
         cin >> flowName;
-        Flow* newFlow = new Flow(flowName);
-        flows.push_back(newFlow);
+        shared_ptr<Flow> newFlow = make_shared<Flow>(flowName);
+        {
+            lock_guard<mutex> lock(flowsMutex);
+            flows.push_back(newFlow);
+        }
         cout << "Flow '" << flowName << "' created successfully." << endl;
-        addStepsToFlow(newFlow);
+        addStepsToFlow(newFlow.get());
     }
 
 
@@ -609,12 +2968,16 @@ public:
         cout << "Enter the name of the flow to delete: ";
         cin >> flowName;
 
-        auto it = find_if(flows.begin(), flows.end(), [&flowName](const Flow* flow) {
+        lock_guard<mutex> lock(flowsMutex);
+        auto it = find_if(flows.begin(), flows.end(), [&flowName](const shared_ptr<Flow>& flow) {
             return flow->name == flowName;
         });
 
         if (it != flows.end()) {
-            delete *it;
+            // Fisierul poate fi rescris cu acelasi continut; atunci flow-ul trebuie incarcat din nou
+            if (!(*it)->sourceFile.empty()) {
+                loadedFileHashes.erase((*it)->sourceFile);
+            }
             flows.erase(it);
             cout << "Flow '" << flowName << "' deleted successfully." << endl;
         } else {
@@ -623,26 +2986,142 @@ public:
     }
 
     void runFlow() {
-        if (flows.empty()) {
+        // Lista afisata ramane valabila cat timp utilizatorul alege, chiar daca watcher-ul schimba flow-urile
+        vector<shared_ptr<Flow>> listedFlows;
+        {
+            lock_guard<mutex> lock(flowsMutex);
+            listedFlows = flows;
+        }
+        if (listedFlows.empty()) {
             cout << "No flows available. Create a flow first." << endl;
             return;
         }
 
         cout << "Select a flow to run:" << endl;
-        for (size_t i = 0; i < flows.size(); ++i) {
-            cout << i + 1 << ". " << flows[i]->name << endl;
+        for (size_t i = 0; i < listedFlows.size(); ++i) {
+            cout << i + 1 << ". " << listedFlows[i]->name << endl;
         }
 
         int choice;
         cout << "Enter the number of the flow to run (0 to cancel): ";
         cin >> choice;
 
-        if (choice > 0 && static_cast<size_t>(choice) <= flows.size()) {
-            flows[choice - 1]->run();
-            flows[choice - 1]->displayAnalytics();
+        shared_ptr<Flow> flow;
+        if (choice > 0 && static_cast<size_t>(choice) <= listedFlows.size()) {
+            flow = listedFlows[choice - 1];
+        }
+        if (flow) {
+            flow->run();
+            flow->displayAnalytics();
+            MemoryBudget::instance().displayUsage();
+            AllocationTracker::instance().display();
         } else {
             cout << "Invalid choice or canceled." << endl;
         }
+    }
+
+    // Porneste procesele worker cu o copie a flow-urilor existente
+    void startWorkerPool() {
+#ifndef _WIN32
+        int workerCount;
+        cout << "Enter the number of worker processes: ";
+        cin >> workerCount;
+        // flowsMutex nu este tinut la fork(): watcher-ul il ia dupa reloadMutex
+        vector<shared_ptr<Flow>> poolFlows;
+        {
+            lock_guard<mutex> lock(flowsMutex);
+            poolFlows = flows;
+        }
+        if (workerPool.start(workerCount, poolFlows)) {
+            cout << "Worker pool started with " << workerCount << " processes." << endl;
+        } else {
+            cout << "Unable to start the worker pool." << endl;
+        }
+#else
+        cout << "The worker pool is not supported on this platform." << endl;
+#endif
+    }
+
+    // Pune in coada mai multe rulari automate ale unui flow
+    void queueRuns() {
+#ifndef _WIN32
+        if (!workerPool.isRunning()) {
+            cout << "Start the worker pool first." << endl;
+            return;
+        }
+        workerPool.supervise();
+        string flowName, input;
+        int runCount;
+        cout << "Enter the name of the flow to run: ";
+        cin >> flowName;
+        cout << "Enter the number of runs: ";
+        cin >> runCount;
+        cout << "Enter the input values for each run, separated by ';': ";
+        cin.ignore();
+        getline(cin, input);
+        replace(input.begin(), input.end(), ';', '\n');
+        for (int i = 0; i < runCount; ++i) {
+            if (!workerPool.submit(flowName, input)) {
+                cout << "Flow '" << flowName << "' is not loaded in the worker pool; no runs were queued." << endl;
+                return;
+            }
+        }
+        cout << runCount << " runs queued for flow '" << flowName << "'." << endl;
+#else
+        cout << "The worker pool is not supported on this platform." << endl;
+#endif
+    }
+
+    void showAnalytics() {
+#ifndef _WIN32
+        workerPool.supervise();
+        workerPool.displayStatus();
+#endif
+        lock_guard<mutex> lock(flowsMutex);
+        for (const auto& flow : flows) {
+            flow->displayAnalytics();
+        }
+        MemoryBudget::instance().displayUsage();
+        AllocationTracker::instance().display();
+    }
+
+    // Incarca toate fisierele .flow din director si le reincarca pe cele modificate (inotify)
+    void watchDirectory(const string& directory) {
+        watchedDirectory = directory;
+        try {
+            for (const auto& entry : filesystem::directory_iterator(directory)) {
+                if (entry.is_regular_file() && entry.path().extension() == FlowFileParser::extension()) {
+                    reloadFlowFile(entry.path().filename().string());
+                }
+            }
+        } catch (const exception& e) {
+            cerr << "Error: " << e.what() << endl;
+            return;
+        }
+#ifdef __linux__
+        inotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+        if (inotifyDescriptor < 0 ||
+            inotify_add_watch(inotifyDescriptor, directory.c_str(),
+                              IN_CLOSE_WRITE | IN_MOVED_TO | IN_MOVED_FROM | IN_DELETE) < 0) {
+            cerr << "Error: Unable to watch directory - " << directory << endl;
+            return;
+        }
+        watching = true;
+        watcher = thread(&FlowManager::watchLoop, this);
+#else
+        cout << "Watching flow files is only supported on Linux; flows were loaded once." << endl;
+#endif
+    }
+
+    void stopWatching() {
+        if (!watching) {
+            return;
+        }
+        watching = false;
+        watcher.join();
+#ifdef __linux__
+        close(inotifyDescriptor);
+#endif
     }
       void addStepsToFlow(Flow* flow) {
         while (true) {
@@ -656,6 +3135,7 @@ public:
             cout << "7. Add Calculus Step" << endl;
             cout << "8. Add Display Step" << endl;
             cout << "9. Add Output Step" << endl;
+            cout << "10. Set deadlines" << endl;
             cout << "0. Add End Step" << endl;
             int choice;
             cout << "Enter your choice: ";
@@ -689,6 +3169,9 @@ public:
                 case 9: 
                     addOutputStep(flow);
                     break;
+                case 10:
+                    setDeadlines(flow);
+                    break;
                 case 0:
                     cout << "Finished adding steps to flow '" << flow->name << "'." << endl;
                     return;
@@ -699,6 +3182,100 @@ public:
     }
 
 private:
+    mutex flowsMutex;
+    mutex reloadMutex; // tinut de watcher pe durata unei reincarcari si de WorkerPool la fork()
+#ifndef _WIN32
+    WorkerPool workerPool{&reloadMutex};
+#endif
+    string watchedDirectory;
+    map<string, size_t> loadedFileHashes; // continutul ultimei versiuni incarcate din fiecare fisier
+    atomic<bool> watching;
+    thread watcher;
+#ifdef __linux__
+    int inotifyDescriptor;
+
+    void watchLoop() {
+        alignas(inotify_event) char buffer[4096];
+        pollfd events = { inotifyDescriptor, POLLIN, 0 };
+        while (watching) {
+            if (poll(&events, 1, 200) <= 0) {
+                continue;
+            }
+            ssize_t length;
+            while ((length = read(inotifyDescriptor, buffer, sizeof(buffer))) > 0) {
+                for (char* position = buffer; position < buffer + length;) {
+                    const inotify_event* event = reinterpret_cast<const inotify_event*>(position);
+                    position += sizeof(inotify_event) + event->len;
+                    if (event->len == 0) {
+                        continue;
+                    }
+                    string fileName = event->name;
+                    if (filesystem::path(fileName).extension() != FlowFileParser::extension()) {
+                        continue;
+                    }
+                    if ((event->mask & (IN_DELETE | IN_MOVED_FROM)) != 0) {
+                        removeFlowFile(fileName);
+                    } else {
+                        reloadFlowFile(fileName);
+                    }
+                }
+            }
+        }
+    }
+#endif
+
+    // Reincarca un singur fisier; flow-ul vechi este inlocuit doar daca cel nou este valid
+    void reloadFlowFile(const string& fileName) {
+        lock_guard<mutex> reloadLock(reloadMutex);
+        string path = (filesystem::path(watchedDirectory) / fileName).string();
+        ifstream fileStream(path);
+        stringstream fileText;
+        fileText << fileStream.rdbuf();
+        size_t fileHash = hash<string>()(fileText.str());
+        {
+            lock_guard<mutex> lock(flowsMutex);
+            auto loaded = loadedFileHashes.find(fileName);
+            if (loaded != loadedFileHashes.end() && loaded->second == fileHash) {
+                return; // nimic nou in fisier
+            }
+        }
+
+        shared_ptr<Flow> newFlow;
+        try {
+            newFlow = FlowFileParser::parse(path, filesystem::path(fileName).stem().string());
+        } catch (const exception& e) {
+            printMessage(stderr, string("Error: ") + e.what());
+            return;
+        }
+        newFlow->sourceFile = fileName;
+
+        lock_guard<mutex> lock(flowsMutex);
+        loadedFileHashes[fileName] = fileHash;
+        auto it = find_if(flows.begin(), flows.end(), [&fileName](const shared_ptr<Flow>& flow) {
+            return flow->sourceFile == fileName;
+        });
+        if (it != flows.end()) {
+            *it = newFlow;
+            printMessage(stdout, "Flow '" + newFlow->name + "' reloaded from " + fileName + ".");
+        } else {
+            flows.push_back(newFlow);
+            printMessage(stdout, "Flow '" + newFlow->name + "' loaded from " + fileName + ".");
+        }
+    }
+
+    void removeFlowFile(const string& fileName) {
+        lock_guard<mutex> reloadLock(reloadMutex); // flow-ul sters poate fi distrus aici
+        lock_guard<mutex> lock(flowsMutex);
+        loadedFileHashes.erase(fileName);
+        auto it = find_if(flows.begin(), flows.end(), [&fileName](const shared_ptr<Flow>& flow) {
+            return flow->sourceFile == fileName;
+        });
+        if (it != flows.end()) {
+            printMessage(stdout, "Flow '" + (*it)->name + "' removed (" + fileName + " deleted).");
+            flows.erase(it);
+        }
+    }
+
     // Metode pentru adaugarea pasilor in flow
     void addTitleStep(Flow* flow) {
         string title, subtitle;
@@ -707,7 +3284,7 @@ private:
         getline(cin, title);
         cout << "Enter the subtitle for the Title Step: ";
         getline(cin, subtitle);
-        flow->addStep(new TitleStep(title, subtitle));
+        flow->addStep(new TitleStep(move(title), move(subtitle)));
         cout << "Title Step added successfully." << endl;
     }
     void addTextStep(Flow* flow) {
@@ -717,7 +3294,7 @@ private:
         getline(cin, title);
         cout << "Enter the copy for the Text Step: ";
         getline(cin, copy);
-        flow->addStep(new TextStep(title, copy));
+        flow->addStep(new TextStep(move(title), move(copy)));
         cout << "Text Step added successfully." << endl;
     }
     void addTextInputStep(Flow* flow) {
@@ -725,7 +3302,7 @@ private:
         cout << "Enter the description for the Text Input Step: ";
         cin.ignore();
         getline(cin, description);
-        flow->addStep(new TextInputStep(description));
+        flow->addStep(new TextInputStep(move(description)));
         cout << "Text Input Step added successfully." << endl;
     }
     void addTextFileInputStep(Flow* flow) {
@@ -735,7 +3312,23 @@ private:
         getline(cin, description);
         cout << "Enter the file name for the Text File Input Step: ";
         getline(cin, fileName);
-        flow->addStep(new TextFileInputStep(description, fileName));
+        int streaming;
+        cout << "Stream the file instead of loading it (for large files)? (yes(1)/no(0)): ";
+        cin >> streaming;
+        if (streaming != 1) {
+            flow->addStep(new TextFileInputStep(move(description), move(fileName)));
+            cout << "Text File Input Step added successfully." << endl;
+            return;
+        }
+        StreamOptions options;
+        cout << "Enter the text to count matching lines for (empty for none): ";
+        cin.ignore();
+        getline(cin, options.pattern);
+        cout << "Enter the number of first lines to show: ";
+        cin >> options.headLines;
+        cout << "Enter the number of last lines to show: ";
+        cin >> options.tailLines;
+        flow->addStep(new TextFileInputStep(move(description), move(fileName), move(options)));
         cout << "Text File Input Step added successfully." << endl;
     }
     void addCsvFileInputStep(Flow* flow) {
@@ -745,7 +3338,7 @@ private:
         getline(cin, description);
         cout << "Enter the file name for the CSV File Input Step: ";
         getline(cin, fileName);
-        flow->addStep(new CsvFileInputStep(description, fileName));
+        flow->addStep(new CsvFileInputStep(move(description), move(fileName)));
         cout << "CSV File Input Step added successfully." << endl;
     }
     void addNumberInputStep(Flow* flow) {
@@ -753,7 +3346,7 @@ private:
         cout << "Enter the description for the Number Input Step: ";
         cin.ignore();
         getline(cin, description);
-        flow->addStep(new NumberInputStep(description));
+        flow->addStep(new NumberInputStep(move(description)));
         cout << "Number Input Step added successfully." << endl;
     }
     
@@ -772,7 +3365,7 @@ private:
         cout << "Enter the operation (+, -, *, /, min, max): ";
         cin >> operation;
 
-        flow->addStep(new CalculusStep(operand1, operand2, operation));
+        flow->addStep(new CalculusStep(operand1.getId(), operand2.getId(), move(operation)));
         cout << "Calculus Step added successfully." << endl;
     }
 
@@ -782,7 +3375,7 @@ private:
         int sourceIndex = getUserChoice("Enter the index of the source step: ", flow->steps.size());
         const Step& sourceStep = *flow->steps[sourceIndex - 1];
 
-        flow->addStep(new DisplayStep(sourceStep));
+        flow->addStep(new DisplayStep(sourceStep.getId()));
         cout << "Display Step added successfully." << endl;
     }
 
@@ -801,10 +3394,33 @@ private:
         cout << "Enter the description for the Output Step: ";
         getline(cin, description);
 
-        flow->addStep(new OutputStep(flow->steps.size() + 1, fileName, title, description, sourceStep));
+        flow->addStep(new OutputStep(flow->steps.size() + 1, move(fileName), move(title), move(description), sourceStep.getId()));
         cout << "Output Step added successfully." << endl;
     }
 
+    void setDeadlines(Flow* flow) {
+        cout << "Enter the deadline for the whole flow in ms (0 for none): ";
+        cin >> flow->deadlineMs;
+        int policy;
+        cout << "After a step times out: continue(0)/abort(1): ";
+        cin >> policy;
+        flow->timeoutPolicy = policy == 1 ? ABORT_ON_TIMEOUT : CONTINUE_ON_TIMEOUT;
+        while (!flow->steps.empty()) {
+            displayAllSteps(flow);
+            int stepIndex;
+            cout << "Enter the index of a step to set its deadline (0 to finish): ";
+            cin >> stepIndex;
+            if (stepIndex < 1 || static_cast<size_t>(stepIndex) > flow->steps.size()) {
+                break;
+            }
+            int stepDeadline;
+            cout << "Enter the deadline for the step in ms (0 for none): ";
+            cin >> stepDeadline;
+            flow->steps[stepIndex - 1]->setDeadlineMs(stepDeadline);
+        }
+        cout << "Deadlines set successfully." << endl;
+    }
+
     void displayAllSteps(const Flow* flow) {
         for (size_t i = 0; i < flow->steps.size(); ++i) {
             cout << i + 1 << ". ";
@@ -831,14 +3447,254 @@ private:
     }
 };
 
-int main() {
+//pas fara output folosit de benchmark: publica rezultatul pasului anterior plus 1
+class BenchmarkStep : public Step {
+public:
+    BenchmarkStep() : Step("BENCHMARK") {}
+
+    void execute(RunContext& context) const override {
+        size_t index = getIndex();
+        double previous = index > 0 ? context.getResultAt(index - 1).number : 0;
+        context.publishNumber(index, previous + 1);
+    }
+    void print(const RunContext&, ostream&) const override {}
+};
+
+// Benchmark: acelasi flow rulat dinamic (Flow) si static (StaticFlow)
+void runBenchmark(int iterations) {
+    Flow dynamicFlow("dynamic");
+    dynamicFlow.addStep(new TitleStep("Benchmark", "Dynamic flow"));
+    NumberInputStep* operand1 = new NumberInputStep("a");
+    NumberInputStep* operand2 = new NumberInputStep("b");
+    dynamicFlow.addStep(operand1);
+    dynamicFlow.addStep(operand2);
+    dynamicFlow.addStep(new CalculusStep(operand1->getId(), operand2->getId(), "+"));
+
+    StaticFlow staticFlow("static", TitleStep("Benchmark", "Static flow"),
+                          NumberInputStep("a"), NumberInputStep("b"), StaticCalculusStep<1, 2, OPERATION_ADD>());
+
+    NullBuffer nullBuffer;
+    streambuf* coutBuffer = cout.rdbuf(&nullBuffer);
+    streambuf* cinBuffer = cin.rdbuf();
+    RunContext dynamicContext = dynamicFlow.createContext();
+    RunContext staticContext = staticFlow.createContext();
+
+    // Rulare interactiva: decizia pentru fiecare pas si cele doua numere
+    string input;
+    for (int i = 0; i < iterations; ++i) {
+        input += "0\n0\n4\n0\n6\n0\n";
+    }
+
+    istringstream dynamicInput(input);
+    cin.rdbuf(dynamicInput.rdbuf());
+    auto start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        dynamicFlow.run(dynamicContext);
+    }
+    double dynamicRunNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    istringstream staticInput(input);
+    cin.rdbuf(staticInput.rdbuf());
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        staticFlow.run(staticContext);
+    }
+    double staticRunNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    // Rulare automata: doar cele doua numere
+    input.clear();
+    for (int i = 0; i < iterations; ++i) {
+        input += "4\n6\n";
+    }
+
+    istringstream dynamicBatchInput(input);
+    cin.rdbuf(dynamicBatchInput.rdbuf());
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        dynamicFlow.runAll(dynamicContext);
+    }
+    double dynamicBatchNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    istringstream staticBatchInput(input);
+    cin.rdbuf(staticBatchInput.rdbuf());
+    start = chrono::steady_clock::now();
+    for (int i = 0; i < iterations; ++i) {
+        staticFlow.runAll(staticContext);
+    }
+    double staticBatchNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+
+    // Pasi fara output, ca scrierile in stream-uri sa nu acopere restul costului
+    // Nu s-a obtinut o diferenta intre apelul direct si cel virtual (~1.0x): domina costul comun al fiecarei
+    // rulari si al fiecarui pas (context, analytics, Flow::executeStep)
+    // Rularile sunt scurte, deci alternam variantele in mai multe runde si pastram cea mai buna runda
+    Flow quietDynamicFlow("dynamic-quiet");
+    for (int i = 0; i < 8; ++i) {
+        quietDynamicFlow.addStep(new BenchmarkStep());
+    }
+    StaticFlow quietStaticFlow("static-quiet", BenchmarkStep(), BenchmarkStep(), BenchmarkStep(), BenchmarkStep(),
+                               BenchmarkStep(), BenchmarkStep(), BenchmarkStep(), BenchmarkStep());
+    RunContext quietDynamicContext = quietDynamicFlow.createContext();
+    RunContext quietStaticContext = quietStaticFlow.createContext();
+
+    double dynamicQuietNs = 0;
+    double staticQuietNs = 0;
+    for (int round = 0; round < 5; ++round) {
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            quietDynamicFlow.runAll(quietDynamicContext);
+        }
+        double roundNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+        dynamicQuietNs = round == 0 ? roundNs : min(dynamicQuietNs, roundNs);
+
+        start = chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            quietStaticFlow.runAll(quietStaticContext);
+        }
+        roundNs = chrono::duration<double, nano>(chrono::steady_clock::now() - start).count() / iterations;
+        staticQuietNs = round == 0 ? roundNs : min(staticQuietNs, roundNs);
+    }
+
+    cin.rdbuf(cinBuffer);
+    cout.rdbuf(coutBuffer);
+
+    cout << "Benchmark (" << iterations << " runs)" << endl;
+    cout << "Interactive run - dynamic: " << dynamicRunNs << " ns/run, static: " << staticRunNs
+         << " ns/run, speedup: " << dynamicRunNs / staticRunNs << "x" << endl;
+    cout << "Batch run - dynamic: " << dynamicBatchNs << " ns/run, static: " << staticBatchNs
+         << " ns/run, speedup: " << dynamicBatchNs / staticBatchNs << "x" << endl;
+    cout << "Batch run without output (8 steps) - dynamic: " << dynamicQuietNs << " ns/run, static: " << staticQuietNs
+         << " ns/run, speedup: " << dynamicQuietNs / staticQuietNs << "x" << endl;
+    staticFlow.displayAnalytics();
+}
+
+// Verificare: rularile repetate ale unui flow incalzit nu trebuie sa aloce memorie pe heap
+// Intoarce codul de iesire al programului (1 daca s-a alocat memorie)
+int checkAllocations(int runs) {
+    const int warmUpRuns = 3;
+    filesystem::path directory = filesystem::temp_directory_path();
+    string textFile = (directory / "flow-allocation-check.txt").string();
+    string csvFile = (directory / "flow-allocation-check.csv").string();
+    string outputFile = (directory / "flow-allocation-check.out").string();
+    {
+        ofstream text(textFile);
+        for (int i = 0; i < 200; ++i) {
+            text << "line " << i << (i % 3 == 0 ? " with a match" : "") << "\n";
+        }
+        ofstream csv(csvFile);
+        csv << "name,value\nfirst,1\nsecond,2\n";
+    }
+
+    AllocationTracker& tracker = AllocationTracker::instance();
+    tracker.setEnabled(true);
+
+    // Toate tipurile de pasi care nu asteapta decizii de la utilizator
+    Flow flow("allocation-check");
+    flow.deadlineMs = 60000;
+    flow.addStep(new TitleStep("Allocation check", "Steady state runs"));
+    flow.addStep(new TextStep("Text", "A copy long enough to live outside the small string buffer"));
+    NumberInputStep* operand1 = new NumberInputStep("a");
+    NumberInputStep* operand2 = new NumberInputStep("b");
+    flow.addStep(operand1);
+    flow.addStep(operand2);
+    CalculusStep* calculus = new CalculusStep(operand1->getId(), operand2->getId(), "*");
+    flow.addStep(calculus);
+    flow.addStep(new TextInputStep("text"));
+    flow.addStep(new TextFileInputStep("text file", textFile));
+    StreamOptions options;
+    options.pattern = "with a match";
+    options.headLines = 2;
+    options.tailLines = 2;
+    flow.addStep(new TextFileInputStep("streamed text file", textFile, options));
+    CsvFileInputStep* csv = new CsvFileInputStep("csv file", csvFile);
+    flow.addStep(csv);
+    flow.addStep(new DisplayStep(calculus->getId()));
+    flow.addStep(new OutputStep(flow.steps.size() + 1, outputFile, "Output", "Allocation check", csv->getId()));
+    calculus->setDeadlineMs(60000);
+
+    string input;
+    for (int i = 0; i < warmUpRuns + runs; ++i) {
+        input += "4\n6\nA line of user input longer than the small string buffer\n";
+    }
+    istringstream inputStream(input);
+    NullBuffer nullBuffer;
+    streambuf* cinBuffer = cin.rdbuf(inputStream.rdbuf());
+    streambuf* coutBuffer = cout.rdbuf(&nullBuffer);
+    RunContext context = flow.createContext();
+
+    for (int i = 0; i < warmUpRuns; ++i) {
+        flow.runAll(context);
+    }
+    long long warmUpCount = tracker.getCount();
+    long long warmUpBytes = tracker.getBytes();
+    for (int i = 0; i < runs; ++i) {
+        flow.runAll(context);
+    }
+    long long steadyCount = tracker.getCount() - warmUpCount;
+    long long steadyBytes = tracker.getBytes() - warmUpBytes;
+
+    cout.rdbuf(coutBuffer);
+    cin.rdbuf(cinBuffer);
+    filesystem::remove(textFile);
+    filesystem::remove(csvFile);
+    filesystem::remove(outputFile);
+
+    cout << "Allocation check (" << runs << " runs after " << warmUpRuns << " warm-up runs)" << endl;
+    cout << "Steady state heap allocations: " << steadyCount << " (" << steadyBytes << " bytes)" << endl;
+    if (flow.errorCount > 0 || flow.timedOutCount > 0) {
+        cout << "FAILED: the flow reported errors, so not every step was checked." << endl;
+        flow.displayAnalytics();
+        return 1;
+    }
+    if (steadyCount > 0) {
+        cout << "FAILED: the hot path allocates memory." << endl;
+        tracker.display();
+        return 1;
+    }
+    cout << "PASSED" << endl;
+    return 0;
+}
+
+int main(int argc, char* argv[]) {
+#ifndef _WIN32
+    cin.rdbuf(&StandardInputBuffer::instance());
+#endif
+    string flowDirectory;
+    for (int i = 1; i < argc; ++i) {
+        string argument = argv[i];
+        if (argument == "--benchmark") {
+            runBenchmark(i + 1 < argc ? atoi(argv[i + 1]) : 100000);
+            return 0;
+        }
+        if (argument == "--check-allocations") {
+            return checkAllocations(i + 1 < argc ? atoi(argv[i + 1]) : 1000);
+        }
+        // Numara alocarile pe heap si le afiseaza langa analytics
+        if (argument == "--count-allocations") {
+            AllocationTracker::instance().setEnabled(true);
+        }
+        // Limita de memorie pentru continutul fisierelor incarcate, in bytes
+        if (argument == "--memory-budget" && i + 1 < argc) {
+            MemoryBudget::instance().setLimit(strtoull(argv[++i], nullptr, 10));
+        }
+        // Director cu fisiere .flow, incarcate la pornire si reincarcate cand se modifica
+        if (argument == "--flows" && i + 1 < argc) {
+            flowDirectory = argv[++i];
+        }
+    }
+
     FlowManager flowManager;
+    if (!flowDirectory.empty()) {
+        flowManager.watchDirectory(flowDirectory);
+    }
 
     while (true) {
         cout << "Menu:" << endl;
         cout << "1. Create a new flow" << endl;
         cout << "2. Delete a flow" << endl;
         cout << "3. Run a flow" << endl;
+        cout << "4. Start worker pool" << endl;
+        cout << "5. Queue runs on the worker pool" << endl;
+        cout << "6. Show analytics" << endl;
         cout << "0. Exit" << endl;
 
         int choice;
@@ -855,6 +3711,15 @@ int main() {
             case 3:
                 flowManager.runFlow();
                 break;
+            case 4:
+                flowManager.startWorkerPool();
+                break;
+            case 5:
+                flowManager.queueRuns();
+                break;
+            case 6:
+                flowManager.showAnalytics();
+                break;
             case 0:
                 cout << "Exiting program." << endl;
                 return 0;